@@ -0,0 +1,86 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sqlitepp::bench
+{
+
+//! Number of global operator new calls so far, counted by the benchmark executable
+std::uint64_t allocationCount();
+
+//! Passed to every benchmark case, measures the throughput of a repeated body
+class BenchState
+{
+public:
+  explicit BenchState(std::chrono::milliseconds minTime) : _minTime(minTime) {}
+
+  //! Calls body repeatedly for at least the minimum time. Each call is expected to process
+  //! itemsPerCall items (rows, statements...). The first call is a warm-up and is not measured.
+  template <typename TBody>
+  void run(std::uint64_t itemsPerCall, TBody&& body);
+
+  std::uint64_t items() const { return _items; }
+  std::chrono::nanoseconds elapsed() const { return _elapsed; }
+  //! Heap allocations made by the measured calls
+  std::uint64_t allocations() const { return _allocations; }
+  double itemsPerSecond() const;
+
+private:
+  std::chrono::milliseconds _minTime;
+  std::uint64_t _items = 0;
+  std::chrono::nanoseconds _elapsed{};
+  std::uint64_t _allocations = 0;
+};
+
+using BenchFunction = void(*)(BenchState&);
+
+struct BenchCase
+{
+  std::string name;
+  BenchFunction function;
+};
+
+//! All cases registered with SQLITEPP_BENCH
+std::vector<BenchCase>& benchRegistry();
+
+struct BenchRegistrar
+{
+  BenchRegistrar(const char* name, BenchFunction function) { benchRegistry().push_back({ name, function }); }
+};
+
+template <typename TBody>
+void BenchState::run(std::uint64_t itemsPerCall, TBody&& body)
+{
+  using Clock = std::chrono::steady_clock;
+  body();
+
+  std::uint64_t allocationsBefore = allocationCount();
+  auto start = Clock::now();
+  auto now = start;
+  do
+  {
+    body();
+    _items += itemsPerCall;
+    now = Clock::now();
+  } while (now - start < _minTime);
+  _elapsed += now - start;
+  _allocations += allocationCount() - allocationsBefore;
+}
+
+inline double BenchState::itemsPerSecond() const
+{
+  if (_elapsed.count() == 0)
+    return 0.0;
+  return static_cast<double>(_items) * 1e9 / static_cast<double>(_elapsed.count());
+}
+
+}
+
+// Defines and registers a benchmark case: SQLITEPP_BENCH(group_name) { ... state.run(n, [&]{ ... }); }
+#define SQLITEPP_BENCH(name) \
+  static void name(::sqlitepp::bench::BenchState& state); \
+  static ::sqlitepp::bench::BenchRegistrar name##_registrar(#name, &name); \
+  static void name(::sqlitepp::bench::BenchState& state)
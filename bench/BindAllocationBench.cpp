@@ -0,0 +1,49 @@
+#include "Bench.h"
+
+#include <sqlite3++/Database.h>
+#include <sqlite3++/Statement.h>
+
+#include <string>
+
+namespace
+{
+
+// longer than the small string buffer, so every copy allocates
+const std::string NAME(64, 'n');
+const std::string EMAIL(64, 'e');
+const std::string NOTE(64, 'x');
+
+}
+
+// Strings passed as lvalues are bound by reference with SQLITE_STATIC, an execute should not allocate
+SQLITEPP_BENCH(bind_strings_execute)
+{
+  sqlitepp::Database db;
+  db.open(":memory:");
+  sqlitepp::Statement<int> lengths("SELECT length(?) + length(?) + length(?)");
+  lengths.Init(&db);
+
+  int total = 0;
+  state.run(1, [&]()
+  {
+    lengths.execute([&](int length) { total += length; }, NAME, EMAIL, NOTE);
+  });
+}
+
+// Temporaries given to query are copied by SQLite (SQLITE_TRANSIENT), the cursor outlives them
+SQLITEPP_BENCH(bind_strings_query_temporaries)
+{
+  sqlitepp::Database db;
+  db.open(":memory:");
+  sqlitepp::Statement<int> lengths("SELECT length(?) + length(?) + length(?)");
+  lengths.Init(&db);
+
+  int total = 0;
+  state.run(1, [&]()
+  {
+    for (auto [length] : lengths.query(std::string(NAME), std::string(EMAIL), std::string(NOTE)))
+    {
+      total += length;
+    }
+  });
+}
@@ -0,0 +1,116 @@
+#include "Bench.h"
+
+#include <sqlite3++/ConnectionPool.h>
+#include <sqlite3++/BulkInserter.h>
+#include <sqlite3++/Statement.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr int ROW_COUNT = 100000;
+constexpr int LOOKUPS_PER_THREAD = 20000;
+
+std::string benchFile()
+{
+  return (std::filesystem::temp_directory_path() / "sqlitepp_bench_pool.sqlite").string();
+}
+
+std::size_t threadCount()
+{
+  return std::max(2u, std::thread::hardware_concurrency());
+}
+
+void createFile(const std::string& path)
+{
+  std::filesystem::remove(path);
+  std::filesystem::remove(path + "-wal");
+  std::filesystem::remove(path + "-shm");
+
+  sqlitepp::Database db;
+  db.open(path.c_str());
+  db.exec("PRAGMA journal_mode=WAL");
+  db.exec("CREATE TABLE items (id INTEGER PRIMARY KEY, value REAL)");
+  sqlitepp::BulkInserter<std::int64_t, double> insert(db, "INSERT INTO items (id, value) VALUES (?, ?)");
+  for (std::int64_t i = 0; i < ROW_COUNT; ++i)
+  {
+    insert.insert(i, i * 0.5);
+  }
+  insert.flush();
+}
+
+// Runs threads point lookups each, lookup(threadIndex, id) does one query
+template <typename TLookup>
+void runThreads(std::size_t threads, TLookup&& lookup)
+{
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&lookup, t]()
+    {
+      lookup(t);
+    });
+  }
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+}
+
+}
+
+// Baseline: all threads share one connection guarded by a mutex, so queries are serialized
+SQLITEPP_BENCH(pool_point_lookup_shared_connection)
+{
+  std::string path = benchFile();
+  createFile(path);
+  sqlitepp::Database db;
+  db.open(path.c_str(), sqlitepp::OpenFlags::READONLY);
+  std::mutex dbMutex;
+  sqlitepp::Statement<double> lookup("SELECT value FROM items WHERE id = ?");
+  lookup.Init(&db);
+
+  std::size_t threads = threadCount();
+  state.run(threads * LOOKUPS_PER_THREAD, [&]()
+  {
+    runThreads(threads, [&](std::size_t t)
+    {
+      double sum = 0;
+      for (int i = 0; i < LOOKUPS_PER_THREAD; ++i)
+      {
+        std::lock_guard lock(dbMutex);
+        lookup.execute([&sum](double value) { sum += value; }, static_cast<std::int64_t>((i * 7919 + t) % ROW_COUNT));
+      }
+    });
+  });
+}
+
+// Each thread leases its own read-only connection from the pool
+SQLITEPP_BENCH(pool_point_lookup_pooled_readers)
+{
+  std::string path = benchFile();
+  createFile(path);
+  std::size_t threads = threadCount();
+  sqlitepp::ConnectionPool pool(path, threads);
+
+  state.run(threads * LOOKUPS_PER_THREAD, [&]()
+  {
+    runThreads(threads, [&](std::size_t t)
+    {
+      auto reader = pool.acquireReader();
+      sqlitepp::Statement<double> lookup("SELECT value FROM items WHERE id = ?");
+      lookup.Init(&reader.get());
+      double sum = 0;
+      for (int i = 0; i < LOOKUPS_PER_THREAD; ++i)
+      {
+        lookup.execute([&sum](double value) { sum += value; }, static_cast<std::int64_t>((i * 7919 + t) % ROW_COUNT));
+      }
+    });
+  });
+}
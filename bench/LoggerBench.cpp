@@ -0,0 +1,77 @@
+#include "Bench.h"
+
+#include <sqlite3++/logging/AsyncLogger.h>
+#include <sqlite3++/logging/OstreamLogger.h>
+
+#include <ostream>
+#include <streambuf>
+
+namespace
+{
+
+constexpr int MESSAGES_PER_CALL = 1000;
+
+// Discards everything, so that only the logger's own cost is measured
+class NullBuffer : public std::streambuf
+{
+protected:
+  virtual int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+  virtual std::streamsize xsputn(const char_type*, std::streamsize count) override { return count; }
+};
+
+}
+
+// Timestamp, formatting and stream output on the calling thread
+SQLITEPP_BENCH(logger_ostream_info)
+{
+  NullBuffer buffer;
+  std::ostream stream(&buffer);
+  sqlitepp::OstreamLoggerBorrowed logger(stream);
+
+  int id = 0;
+  state.run(MESSAGES_PER_CALL, [&]()
+  {
+    for (int i = 0; i < MESSAGES_PER_CALL; ++i)
+    {
+      logger.info("Executed statement {} in {} us", ++id, 42);
+    }
+  });
+}
+
+// The caller only formats into the queue, the sink runs on the background thread
+SQLITEPP_BENCH(logger_async_info)
+{
+  NullBuffer buffer;
+  std::ostream stream(&buffer);
+  sqlitepp::OstreamLoggerBorrowed sink(stream);
+  sqlitepp::AsyncLogger logger(sink, 1 << 16);
+
+  int id = 0;
+  state.run(MESSAGES_PER_CALL, [&]()
+  {
+    for (int i = 0; i < MESSAGES_PER_CALL; ++i)
+    {
+      logger.info("Executed statement {} in {} us", ++id, 42);
+    }
+  });
+  logger.flush();
+}
+
+// A message below the logger level is dropped before any formatting
+SQLITEPP_BENCH(logger_filtered_trace)
+{
+  NullBuffer buffer;
+  std::ostream stream(&buffer);
+  sqlitepp::OstreamLoggerBorrowed sink(stream);
+  sqlitepp::AsyncLogger logger(sink);
+  logger.setLevel(sqlitepp::Logger::Level::INFO);
+
+  int id = 0;
+  state.run(MESSAGES_PER_CALL, [&]()
+  {
+    for (int i = 0; i < MESSAGES_PER_CALL; ++i)
+    {
+      logger.trace("Read column {}", ++id);
+    }
+  });
+}
@@ -0,0 +1,122 @@
+#include "Bench.h"
+
+#include <sqlite3++/Database.h>
+#include <sqlite3++/Statement.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// File backed workloads for comparing builds with different SQLITEPP_SQLITE_PROFILE settings.
+// Journal mode, synchronous, page cache and mmap only matter for real files, in memory databases
+// used by the other cases hide them. See scripts/compare_sqlite_profiles.cmake.
+namespace
+{
+
+constexpr int ROW_COUNT = 50000;
+constexpr int ROWS_PER_TRANSACTION = 100;
+constexpr int LOOKUPS_PER_CALL = 1000;
+
+constexpr const char* CREATE_EVENTS = R"SQL(
+  CREATE TABLE IF NOT EXISTS events (id INTEGER PRIMARY KEY, kind INTEGER, at INTEGER, payload TEXT);
+  CREATE INDEX IF NOT EXISTS events_kind_at ON events (kind, at);
+)SQL";
+
+constexpr const char* FILL_EVENTS = R"SQL(
+  WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 50000)
+  INSERT INTO events (id, kind, at, payload)
+  SELECT n, CASE WHEN n % 100 = 0 THEN n % 7 ELSE 0 END, n * 10, printf('%.100c', 'p') FROM seq;
+  ANALYZE;
+)SQL";
+
+// Database file in the temp directory, removed together with its WAL and journal
+struct TempDatabaseFile
+{
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "sqlite3++_profile_bench.db";
+
+  TempDatabaseFile() { remove(); }
+  ~TempDatabaseFile() { remove(); }
+
+  void remove()
+  {
+    std::error_code ignored;
+    for (const char* suffix : { "", "-wal", "-shm", "-journal" })
+      std::filesystem::remove(path.string() + suffix, ignored);
+  }
+};
+
+struct FileFixture
+{
+  // declared first so the files are removed after the connection is closed
+  TempDatabaseFile file;
+  sqlitepp::Database db;
+
+  explicit FileFixture(bool fill)
+  {
+    db.open(file.path.string().c_str());
+    db.exec(CREATE_EVENTS);
+    if (fill)
+      db.exec(FILL_EVENTS);
+  }
+};
+
+std::uint32_t nextRandom(std::uint32_t& seed)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return seed;
+}
+
+}
+
+// Many small transactions, dominated by journaling and syncing
+SQLITEPP_BENCH(profile_file_small_transactions)
+{
+  FileFixture fixture(false);
+  sqlitepp::Statement<> insert("INSERT INTO events (kind, at, payload) VALUES (?, ?, ?)");
+  insert.Init(&fixture.db);
+
+  const std::string payload(100, 'p');
+  std::int64_t at = 0;
+  state.run(ROWS_PER_TRANSACTION, [&]()
+  {
+    fixture.db.exec("BEGIN");
+    for (int i = 0; i < ROWS_PER_TRANSACTION; ++i)
+    {
+      insert.execute([]() {}, i % 7, ++at, payload);
+    }
+    fixture.db.exec("COMMIT");
+  });
+}
+
+// Random primary key reads, served from the page cache or the memory map
+SQLITEPP_BENCH(profile_file_point_lookup)
+{
+  FileFixture fixture(true);
+  sqlitepp::Statement<std::int64_t> lookup("SELECT at FROM events WHERE id = ?");
+  lookup.Init(&fixture.db);
+
+  std::int64_t sum = 0;
+  std::uint32_t seed = 1;
+  state.run(LOOKUPS_PER_CALL, [&]()
+  {
+    for (int i = 0; i < LOOKUPS_PER_CALL; ++i)
+    {
+      lookup.execute([&](std::int64_t value) { sum += value; }, static_cast<std::int64_t>(nextRandom(seed) % ROW_COUNT) + 1);
+    }
+  });
+}
+
+// Filter on a heavily skewed column, STAT4 lets the planner pick the index for rare kinds
+SQLITEPP_BENCH(profile_file_skewed_filter)
+{
+  FileFixture fixture(true);
+  sqlitepp::Statement<std::int64_t> count("SELECT count(*) FROM events WHERE kind = ? AND at > ?");
+  count.Init(&fixture.db);
+
+  std::int64_t total = 0;
+  std::uint32_t seed = 1;
+  state.run(1, [&]()
+  {
+    count.execute([&](std::int64_t value) { total += value; }, static_cast<int>(nextRandom(seed) % 6) + 1, 0);
+  });
+}
@@ -0,0 +1,62 @@
+#include "Bench.h"
+
+#include <sqlite3++/Database.h>
+#include <sqlite3++/Statement.h>
+
+#include <cstdint>
+
+namespace
+{
+
+constexpr int ROW_COUNT = 10000;
+
+void fillTable(sqlitepp::Database& db)
+{
+  db.open(":memory:");
+  db.exec("CREATE TABLE rows (id INTEGER PRIMARY KEY, value REAL)");
+  db.exec(R"SQL(
+    WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 10000)
+    INSERT INTO rows (id, value) SELECT n, n * 0.5 FROM seq
+  )SQL");
+}
+
+}
+
+// Rows are handed to a std::function RowHandler, which goes through two type erased calls per row
+SQLITEPP_BENCH(row_dispatch_std_function)
+{
+  sqlitepp::Database db;
+  fillTable(db);
+  sqlitepp::Statement<std::int64_t, double> scan("SELECT id, value FROM rows");
+  scan.Init(&db);
+
+  std::int64_t idSum = 0;
+  double valueSum = 0;
+  sqlitepp::Statement<std::int64_t, double>::RowHandler handler = [&](std::int64_t id, double value)
+  {
+    idSum += id;
+    valueSum += value;
+    return true;
+  };
+  state.run(ROW_COUNT, [&]() { scan.execute(handler); });
+}
+
+// Same scan with a lambda, decoding and the handler are inlined in the step loop
+SQLITEPP_BENCH(row_dispatch_inline)
+{
+  sqlitepp::Database db;
+  fillTable(db);
+  sqlitepp::Statement<std::int64_t, double> scan("SELECT id, value FROM rows");
+  scan.Init(&db);
+
+  std::int64_t idSum = 0;
+  double valueSum = 0;
+  state.run(ROW_COUNT, [&]()
+  {
+    scan.execute([&](std::int64_t id, double value)
+    {
+      idSum += id;
+      valueSum += value;
+    });
+  });
+}
@@ -0,0 +1,252 @@
+#include "Bench.h"
+
+#include <sqlite3++/Database.h>
+#include <sqlite3++/Statement.h>
+#include <sqlite3++/BulkInserter.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sqlite3.h"
+
+// Every case is paired with a hand written C API baseline doing the same work, the difference
+// between the two is the cost of the wrapper.
+namespace
+{
+
+constexpr int ROW_COUNT = 10000;
+constexpr int INSERT_BATCH = 1000;
+constexpr int LOOKUPS_PER_CALL = 1000;
+
+constexpr const char* CREATE_ITEMS = R"SQL(
+  CREATE TABLE items (id INTEGER PRIMARY KEY, value REAL, name TEXT, description TEXT);
+  WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 10000)
+  INSERT INTO items (id, value, name, description)
+  SELECT n, n * 0.5, 'item ' || n, printf('%.200c', 'd') FROM seq;
+)SQL";
+
+// Two separate in memory databases with the same content, one behind the wrapper and one raw
+struct Fixture
+{
+  sqlitepp::Database db;
+  sqlite3* raw = nullptr;
+
+  Fixture()
+  {
+    db.open(":memory:");
+    db.exec(CREATE_ITEMS);
+    sqlite3_open(":memory:", &raw);
+    sqlite3_exec(raw, CREATE_ITEMS, nullptr, nullptr, nullptr);
+  }
+
+  ~Fixture()
+  {
+    sqlite3_close_v2(raw);
+  }
+};
+
+// Deterministic pseudo random ids, the same sequence for both variants
+int nextId(std::uint32_t& seed)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return static_cast<int>(seed % ROW_COUNT) + 1;
+}
+
+}
+
+SQLITEPP_BENCH(point_lookup_wrapper)
+{
+  Fixture fixture;
+  sqlitepp::Statement<double> lookup("SELECT value FROM items WHERE id = ?");
+  lookup.Init(&fixture.db);
+
+  double sum = 0;
+  std::uint32_t seed = 1;
+  state.run(LOOKUPS_PER_CALL, [&]()
+  {
+    for (int i = 0; i < LOOKUPS_PER_CALL; ++i)
+    {
+      lookup.execute([&](double value) { sum += value; }, nextId(seed));
+    }
+  });
+}
+
+SQLITEPP_BENCH(point_lookup_raw)
+{
+  Fixture fixture;
+  sqlite3_stmt* lookup = nullptr;
+  sqlite3_prepare_v3(fixture.raw, "SELECT value FROM items WHERE id = ?", -1, SQLITE_PREPARE_PERSISTENT, &lookup, nullptr);
+
+  double sum = 0;
+  std::uint32_t seed = 1;
+  state.run(LOOKUPS_PER_CALL, [&]()
+  {
+    for (int i = 0; i < LOOKUPS_PER_CALL; ++i)
+    {
+      sqlite3_bind_int(lookup, 1, nextId(seed));
+      while (sqlite3_step(lookup) == SQLITE_ROW)
+      {
+        sum += sqlite3_column_double(lookup, 0);
+      }
+      sqlite3_reset(lookup);
+      sqlite3_clear_bindings(lookup);
+    }
+  });
+  sqlite3_finalize(lookup);
+}
+
+SQLITEPP_BENCH(full_scan_wrapper)
+{
+  Fixture fixture;
+  sqlitepp::Statement<std::int64_t, double> scan("SELECT id, value FROM items");
+  scan.Init(&fixture.db);
+
+  std::int64_t idSum = 0;
+  double valueSum = 0;
+  state.run(ROW_COUNT, [&]()
+  {
+    scan.execute([&](std::int64_t id, double value)
+    {
+      idSum += id;
+      valueSum += value;
+    });
+  });
+}
+
+SQLITEPP_BENCH(full_scan_raw)
+{
+  Fixture fixture;
+  sqlite3_stmt* scan = nullptr;
+  sqlite3_prepare_v3(fixture.raw, "SELECT id, value FROM items", -1, SQLITE_PREPARE_PERSISTENT, &scan, nullptr);
+
+  std::int64_t idSum = 0;
+  double valueSum = 0;
+  state.run(ROW_COUNT, [&]()
+  {
+    while (sqlite3_step(scan) == SQLITE_ROW)
+    {
+      idSum += sqlite3_column_int64(scan, 0);
+      valueSum += sqlite3_column_double(scan, 1);
+    }
+    sqlite3_reset(scan);
+  });
+  sqlite3_finalize(scan);
+}
+
+SQLITEPP_BENCH(bulk_insert_wrapper)
+{
+  Fixture fixture;
+  fixture.db.exec("CREATE TABLE inserted (id INTEGER, value REAL, name TEXT)");
+  const std::string name = "inserted row";
+
+  int id = 0;
+  state.run(INSERT_BATCH, [&]()
+  {
+    sqlitepp::BulkInserter<int, double, std::string> inserter(fixture.db, "INSERT INTO inserted VALUES (?, ?, ?)", INSERT_BATCH);
+    for (int i = 0; i < INSERT_BATCH; ++i, ++id)
+    {
+      inserter.insert(id, id * 0.5, name);
+    }
+    inserter.flush();
+  });
+}
+
+SQLITEPP_BENCH(bulk_insert_raw)
+{
+  Fixture fixture;
+  sqlite3_exec(fixture.raw, "CREATE TABLE inserted_raw (id INTEGER, value REAL, name TEXT)", nullptr, nullptr, nullptr);
+  sqlite3_stmt* insert = nullptr;
+  sqlite3_prepare_v3(fixture.raw, "INSERT INTO inserted_raw VALUES (?, ?, ?)", -1, SQLITE_PREPARE_PERSISTENT, &insert, nullptr);
+  const std::string name = "inserted row";
+
+  int id = 0;
+  state.run(INSERT_BATCH, [&]()
+  {
+    sqlite3_exec(fixture.raw, "BEGIN IMMEDIATE", nullptr, nullptr, nullptr);
+    for (int i = 0; i < INSERT_BATCH; ++i, ++id)
+    {
+      sqlite3_bind_int(insert, 1, id);
+      sqlite3_bind_double(insert, 2, id * 0.5);
+      sqlite3_bind_text(insert, 3, name.data(), static_cast<int>(name.size()), SQLITE_STATIC);
+      sqlite3_step(insert);
+      sqlite3_reset(insert);
+      sqlite3_clear_bindings(insert);
+    }
+    sqlite3_exec(fixture.raw, "COMMIT", nullptr, nullptr, nullptr);
+  });
+  sqlite3_finalize(insert);
+}
+
+// Many parameters and a trivial query, so the time is dominated by binding
+SQLITEPP_BENCH(bind_heavy_wrapper)
+{
+  Fixture fixture;
+  sqlitepp::Statement<int> sum("SELECT ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ?");
+  sum.Init(&fixture.db);
+
+  int total = 0;
+  state.run(1, [&]()
+  {
+    sum.execute([&](int value) { total += value; }, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+  });
+}
+
+SQLITEPP_BENCH(bind_heavy_raw)
+{
+  Fixture fixture;
+  sqlite3_stmt* sum = nullptr;
+  sqlite3_prepare_v3(fixture.raw, "SELECT ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ? + ?", -1, SQLITE_PREPARE_PERSISTENT, &sum, nullptr);
+
+  int total = 0;
+  state.run(1, [&]()
+  {
+    for (int i = 1; i <= 16; ++i)
+    {
+      sqlite3_bind_int(sum, i, i);
+    }
+    while (sqlite3_step(sum) == SQLITE_ROW)
+    {
+      total += sqlite3_column_int(sum, 0);
+    }
+    sqlite3_reset(sum);
+    sqlite3_clear_bindings(sum);
+  });
+  sqlite3_finalize(sum);
+}
+
+// Rows with two text columns read as views, no copies on either side
+SQLITEPP_BENCH(string_rows_wrapper)
+{
+  Fixture fixture;
+  sqlitepp::Statement<std::string_view, std::string_view> scan("SELECT name, description FROM items");
+  scan.Init(&fixture.db);
+
+  std::size_t bytes = 0;
+  state.run(ROW_COUNT, [&]()
+  {
+    scan.execute([&](std::string_view name, std::string_view description) { bytes += name.size() + description.size(); });
+  });
+}
+
+SQLITEPP_BENCH(string_rows_raw)
+{
+  Fixture fixture;
+  sqlite3_stmt* scan = nullptr;
+  sqlite3_prepare_v3(fixture.raw, "SELECT name, description FROM items", -1, SQLITE_PREPARE_PERSISTENT, &scan, nullptr);
+
+  std::size_t bytes = 0;
+  state.run(ROW_COUNT, [&]()
+  {
+    while (sqlite3_step(scan) == SQLITE_ROW)
+    {
+      sqlite3_column_text(scan, 0);
+      bytes += static_cast<std::size_t>(sqlite3_column_bytes(scan, 0));
+      sqlite3_column_text(scan, 1);
+      bytes += static_cast<std::size_t>(sqlite3_column_bytes(scan, 1));
+    }
+    sqlite3_reset(scan);
+  });
+  sqlite3_finalize(scan);
+}
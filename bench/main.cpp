@@ -0,0 +1,80 @@
+#include "Bench.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "sqlite3.h"
+
+namespace
+{
+std::atomic<std::uint64_t> allocations{ 0 };
+}
+
+// Counting replacements of the global allocation functions, the array and nothrow forms forward to these
+void* operator new(std::size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size == 0 ? 1 : size))
+    return memory;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+namespace sqlitepp::bench
+{
+
+std::uint64_t allocationCount()
+{
+  return allocations.load(std::memory_order_relaxed);
+}
+
+std::vector<BenchCase>& benchRegistry()
+{
+  static std::vector<BenchCase> registry;
+  return registry;
+}
+
+}
+
+// usage: sqlite3++_bench [name filter] [min milliseconds per case]
+int main(int argc, char** argv)
+{
+  using namespace sqlitepp::bench;
+
+  const char* filter = argc > 1 ? argv[1] : "";
+  int minMs = argc > 2 ? std::atoi(argv[2]) : 500;
+
+  // identifies the build profile when comparing outputs of differently configured builds
+  std::printf("sqlite %s compiled with:", sqlite3_libversion());
+  for (int i = 0; const char* option = sqlite3_compileoption_get(i); ++i)
+  {
+    std::printf(" %s", option);
+  }
+  std::printf("\n\n");
+
+  std::printf("%-44s %16s %12s %12s\n", "case", "items/s", "ns/item", "allocs/item");
+  for (const BenchCase& benchCase : benchRegistry())
+  {
+    if (std::strstr(benchCase.name.c_str(), filter) == nullptr)
+      continue;
+
+    BenchState state{ std::chrono::milliseconds(minMs) };
+    benchCase.function(state);
+    double nsPerItem = state.items() == 0 ? 0.0 : static_cast<double>(state.elapsed().count()) / static_cast<double>(state.items());
+    double allocsPerItem = state.items() == 0 ? 0.0 : static_cast<double>(state.allocations()) / static_cast<double>(state.items());
+    std::printf("%-44s %16.0f %12.1f %12.2f\n", benchCase.name.c_str(), state.itemsPerSecond(), nsPerItem, allocsPerItem);
+  }
+  return 0;
+}
@@ -0,0 +1,274 @@
+#pragma once
+#include "Database.h"
+#include "Statement.h"
+#include "flags.h"
+#include "generic/NoCopy.h"
+#include "traits/ReadTraits.h"
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace sqlitepp
+{
+
+struct AsyncQueueStats
+{
+  // Tasks waiting in the queue right now
+  std::size_t depth = 0;
+  std::size_t maxDepth = 0;
+  std::uint64_t submitted = 0;
+  std::uint64_t completed = 0;
+  // trySubmit calls refused because the queue was full
+  std::uint64_t rejected = 0;
+};
+
+//! Awaitable result of AsyncDatabase::schedule. The coroutine is resumed through the
+//! database's resume executor, by default directly on the database thread.
+template <typename TResult>
+class AsyncTask
+{
+public:
+  using value_type = std::conditional_t<std::is_void_v<TResult>, std::monostate, TResult>;
+
+  struct State
+  {
+    std::mutex mutex;
+    bool ready = false;
+    std::optional<value_type> value;
+    std::exception_ptr error;
+    std::coroutine_handle<> waiter;
+    std::function<void(std::coroutine_handle<>)> resume;
+
+    void complete()
+    {
+      std::coroutine_handle<> toResume;
+      {
+        std::lock_guard lock(mutex);
+        ready = true;
+        toResume = waiter;
+      }
+      if (toResume)
+      {
+        if (resume)
+          resume(toResume);
+        else
+          toResume.resume();
+      }
+    }
+  };
+
+  explicit AsyncTask(std::shared_ptr<State> state) : _state(std::move(state)) {}
+
+  bool await_ready() const
+  {
+    std::lock_guard lock(_state->mutex);
+    return _state->ready;
+  }
+  bool await_suspend(std::coroutine_handle<> handle)
+  {
+    std::lock_guard lock(_state->mutex);
+    if (_state->ready)
+      return false;
+    _state->waiter = handle;
+    return true;
+  }
+  TResult await_resume()
+  {
+    if (_state->error)
+      std::rethrow_exception(_state->error);
+    if constexpr (!std::is_void_v<TResult>)
+      return std::move(*_state->value);
+  }
+
+private:
+  std::shared_ptr<State> _state;
+};
+
+//! Owns a connection on a dedicated thread and runs submitted work there, so that callers
+//! (typically an event loop) never block inside SQLite. Work is queued in submission order.
+//! The queue is bounded: submit and schedule block when it is full, trySubmit refuses instead.
+//! Work running on the database thread cannot block for room, there submit, schedule, query
+//! and exec throw SQLiteError when the queue is full.
+class AsyncDatabase : public NoCopy
+{
+public:
+  static constexpr std::size_t DEFAULT_QUEUE_CAPACITY = 1024;
+
+  AsyncDatabase(const std::string& path, OpenFlags flags = OpenFlags::READWRITE | OpenFlags::CREATE, std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+  //! Finishes all queued work, then stops the thread
+  ~AsyncDatabase();
+
+  //! Runs func(Database&) on the database thread, blocks while the queue is full
+  template <typename TFunc>
+  auto submit(TFunc&& func) -> std::future<std::invoke_result_t<TFunc&, Database&>>;
+  //! Like submit, but returns std::nullopt instead of blocking when the queue is full
+  template <typename TFunc>
+  auto trySubmit(TFunc&& func) -> std::optional<std::future<std::invoke_result_t<TFunc&, Database&>>>;
+  //! Like submit, but returns an awaitable for use in coroutines: auto rows = co_await db.schedule(...);
+  template <typename TFunc>
+  auto schedule(TFunc&& func) -> AsyncTask<std::invoke_result_t<TFunc&, Database&>>;
+
+  //! Executes the query on the database thread and collects all rows. Values are copied into the task.
+  template <typename... TResults, typename... TValues>
+  std::future<std::vector<std::tuple<TResults...>>> query(std::string sql, TValues... values);
+  //! Executes SQL that returns no rows
+  std::future<void> exec(std::string sql);
+
+  //! Executor used to resume coroutines waiting on schedule, for example a post to the event loop.
+  //! Must be set before any work is scheduled.
+  void setResumeExecutor(std::function<void(std::coroutine_handle<>)> executor) { _resumeExecutor = std::move(executor); }
+
+  AsyncQueueStats getStats() const;
+
+private:
+  struct Task
+  {
+    virtual ~Task() = default;
+    virtual void run(Database& db) = 0;
+  };
+
+  template <typename TFunc, typename TDone>
+  struct FunctionTask : public Task
+  {
+    FunctionTask(TFunc&& func, TDone&& done) : func(std::forward<TFunc>(func)), done(std::move(done)) {}
+    virtual void run(Database& db) override { done(func, db); }
+
+    std::decay_t<TFunc> func;
+    TDone done;
+  };
+
+  Database _db;
+  std::size_t _capacity;
+  std::deque<std::unique_ptr<Task>> _queue;
+  mutable std::mutex _mutex;
+  std::condition_variable _notEmpty;
+  std::condition_variable _notFull;
+  bool _stopping = false;
+  AsyncQueueStats _stats;
+  std::function<void(std::coroutine_handle<>)> _resumeExecutor;
+  std::thread _worker;
+
+  //! Adds task to the queue, returns false if the queue is full and block is false
+  bool enqueue(std::unique_ptr<Task>& task, bool block);
+  void workerLoop();
+
+  template <typename TFunc>
+  static std::unique_ptr<Task> makeFutureTask(TFunc&& func, std::promise<std::invoke_result_t<TFunc&, Database&>>& promise);
+};
+
+template <typename TFunc>
+std::unique_ptr<AsyncDatabase::Task> AsyncDatabase::makeFutureTask(TFunc&& func, std::promise<std::invoke_result_t<TFunc&, Database&>>& promise)
+{
+  using Result = std::invoke_result_t<TFunc&, Database&>;
+  auto done = [promise = std::move(promise)](auto& f, Database& db) mutable
+  {
+    try
+    {
+      if constexpr (std::is_void_v<Result>)
+      {
+        f(db);
+        promise.set_value();
+      }
+      else
+      {
+        promise.set_value(f(db));
+      }
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+    }
+  };
+  return std::make_unique<FunctionTask<TFunc, decltype(done)>>(std::forward<TFunc>(func), std::move(done));
+}
+
+template <typename TFunc>
+auto AsyncDatabase::submit(TFunc&& func) -> std::future<std::invoke_result_t<TFunc&, Database&>>
+{
+  std::promise<std::invoke_result_t<TFunc&, Database&>> promise;
+  auto future = promise.get_future();
+  auto task = makeFutureTask(std::forward<TFunc>(func), promise);
+  enqueue(task, true);
+  return future;
+}
+
+template <typename TFunc>
+auto AsyncDatabase::trySubmit(TFunc&& func) -> std::optional<std::future<std::invoke_result_t<TFunc&, Database&>>>
+{
+  std::promise<std::invoke_result_t<TFunc&, Database&>> promise;
+  auto future = promise.get_future();
+  auto task = makeFutureTask(std::forward<TFunc>(func), promise);
+  if (!enqueue(task, false))
+  {
+    return std::nullopt;
+  }
+  return future;
+}
+
+template <typename TFunc>
+auto AsyncDatabase::schedule(TFunc&& func) -> AsyncTask<std::invoke_result_t<TFunc&, Database&>>
+{
+  using Result = std::invoke_result_t<TFunc&, Database&>;
+  auto state = std::make_shared<typename AsyncTask<Result>::State>();
+  state->resume = _resumeExecutor;
+
+  auto done = [state](auto& f, Database& db)
+  {
+    try
+    {
+      if constexpr (std::is_void_v<Result>)
+      {
+        f(db);
+        state->value.emplace();
+      }
+      else
+      {
+        state->value.emplace(f(db));
+      }
+    }
+    catch (...)
+    {
+      state->error = std::current_exception();
+    }
+    state->complete();
+  };
+  std::unique_ptr<Task> task = std::make_unique<FunctionTask<TFunc, decltype(done)>>(std::forward<TFunc>(func), std::move(done));
+  enqueue(task, true);
+  return AsyncTask<Result>(std::move(state));
+}
+
+template <typename... TResults, typename... TValues>
+std::future<std::vector<std::tuple<TResults...>>> AsyncDatabase::query(std::string sql, TValues... values)
+{
+  static_assert((!is_unowned_column_v<TResults> && ...),
+    "Unowned column values are only valid on the database thread, read owning types instead.");
+
+  return submit([sql = std::move(sql), args = std::make_tuple(std::move(values)...)](Database& db)
+  {
+    std::vector<std::tuple<TResults...>> rows;
+    Statement<TResults...> statement(sql);
+    statement.Init(&db);
+    std::apply([&](const auto&... boundValues)
+    {
+      statement.execute([&rows](TResults... row) { rows.emplace_back(std::move(row)...); }, boundValues...);
+    }, args);
+    return rows;
+  });
+}
+
+}
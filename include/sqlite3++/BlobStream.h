@@ -0,0 +1,82 @@
+#pragma once
+#include "generic/NoCopy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace sqlitepp
+{
+
+class Database;
+
+//! Incremental access to a single BLOB value, so that large objects can be read and written
+//! in chunks without holding the whole value in memory. The blob cannot change size, to write
+//! a new value bind a ZeroBlob of the final size first and then fill it in.
+//! The handle is invalidated when the row is modified or deleted by any statement,
+//! reads and writes then throw with ResultCode::ABORT.
+class BlobStream : public NoCopy
+{
+public:
+  BlobStream(Database& db, const std::string& table, const std::string& column, std::int64_t rowid, bool writable = false, const std::string& schema = "main");
+  BlobStream(BlobStream&& other);
+  ~BlobStream();
+
+  //! Points the handle to the same column in another row, much cheaper than opening a new handle
+  void reopen(std::int64_t rowid);
+  void close();
+  bool isOpen() const;
+
+  //! Size of the blob in bytes
+  std::size_t size() const;
+  bool isWritable() const { return _writable; }
+
+  //! Reads exactly size bytes starting at offset, throws if the range is past the end of the blob
+  void read(void* buffer, std::size_t size, std::size_t offset) const;
+  //! Overwrites size bytes starting at offset, the blob cannot be extended
+  void write(const void* buffer, std::size_t size, std::size_t offset);
+
+private:
+  struct Private;
+  std::unique_ptr<Private> _private;
+  bool _writable;
+};
+
+//! std::streambuf over a BlobStream, buffering at most chunkSize bytes at a time.
+//! Supports both reading and writing (when the blob was opened writable) and seeking.
+//! Writing past the end of the blob fails like writing to a full device.
+class BlobStreamBuf : public std::streambuf
+{
+public:
+  static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+  explicit BlobStreamBuf(BlobStream& blob, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+  //! Flushes pending writes, errors are ignored - flush the stream first to detect them
+  virtual ~BlobStreamBuf() override;
+
+protected:
+  virtual int_type underflow() override;
+  virtual int_type overflow(int_type ch) override;
+  virtual int sync() override;
+  virtual std::streamsize xsgetn(char_type* s, std::streamsize count) override;
+  virtual std::streamsize xsputn(const char_type* s, std::streamsize count) override;
+  virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+  virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+  virtual std::streamsize showmanyc() override;
+
+private:
+  BlobStream& _blob;
+  std::vector<char> _buffer;
+  // blob offset of the first byte in _buffer
+  std::size_t _bufferOffset = 0;
+
+  //! Writes out the put area, throws on failure
+  void flushWrites();
+  //! Blob offset of the next byte that would be read or written
+  std::size_t position() const;
+};
+
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include "Database.h"
+#include "Statement.h"
+#include "Transaction.h"
+#include "generic/NoCopy.h"
+#include "logging/Logger.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <string>
+#include <tuple>
+
+namespace sqlitepp
+{
+
+struct BulkInsertStats
+{
+  std::uint64_t rows = 0;
+  // Number of committed transactions
+  std::uint64_t transactions = 0;
+  // Time spent inside insert and flush calls
+  std::chrono::nanoseconds elapsed{};
+
+  double rowsPerSecond() const
+  {
+    return elapsed.count() == 0 ? 0.0 : static_cast<double>(rows) * 1e9 / static_cast<double>(elapsed.count());
+  }
+};
+
+//! Inserts many rows through one prepared statement, committing every batchSize rows
+//! instead of paying for a transaction (and fsync) per row.
+//! BulkInserter<std::int64_t, std::string> ins(db, "INSERT INTO t (id, name) VALUES (?, ?)");
+//! ins.insertAll(rows); ins.flush();
+//! If the database is already in a transaction, rows are added to it and nothing is committed.
+//! Pending rows are committed by the destructor, or rolled back if it runs because of an exception.
+template <typename... TValues>
+class BulkInserter : public NoCopy
+{
+public:
+  static constexpr std::size_t DEFAULT_BATCH_SIZE = 10000;
+
+  BulkInserter(Database& db, const std::string& query, std::size_t batchSize = DEFAULT_BATCH_SIZE);
+  ~BulkInserter();
+
+  //! Inserts one row, commits when the batch is full
+  void insert(const TValues&... values);
+  //! Inserts every element of a range of std::tuple<TValues...> (or anything std::apply accepts)
+  template <typename TRange>
+  void insertAll(const TRange& rows);
+  //! Commits the rows inserted so far
+  void flush();
+
+  const BulkInsertStats& getStats() const { return _stats; }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  Database& _db;
+  Statement<> _insert;
+  std::size_t _batchSize;
+  std::size_t _pending = 0;
+  // set while this inserter has its own transaction open
+  std::optional<Transaction> _transaction;
+  BulkInsertStats _stats;
+  // exceptions already in flight when the inserter was created, more than that means the scope failed
+  int _uncaughtExceptions;
+
+  void insertRow(const TValues&... values);
+  void commit();
+};
+
+template <typename... TValues>
+BulkInserter<TValues...>::BulkInserter(Database& db, const std::string& query, std::size_t batchSize)
+  : _db(db)
+  , _insert(query)
+  , _batchSize(batchSize == 0 ? 1 : batchSize)
+  , _uncaughtExceptions(std::uncaught_exceptions())
+{
+  _insert.Init(&db);
+}
+
+template <typename... TValues>
+BulkInserter<TValues...>::~BulkInserter()
+{
+  // when unwinding out of the inserter's scope, the Transaction destructor rolls back
+  if (!_transaction || std::uncaught_exceptions() > _uncaughtExceptions)
+    return;
+
+  try
+  {
+    commit();
+  }
+  catch (const std::exception& e)
+  {
+    _db.getLogger().error("Failed to finish bulk insert transaction: {}", e.what());
+  }
+}
+
+template <typename... TValues>
+void BulkInserter<TValues...>::insert(const TValues&... values)
+{
+  auto start = Clock::now();
+  insertRow(values...);
+  _stats.elapsed += Clock::now() - start;
+}
+
+template <typename... TValues>
+template <typename TRange>
+void BulkInserter<TValues...>::insertAll(const TRange& rows)
+{
+  auto start = Clock::now();
+  for (const auto& row : rows)
+  {
+    std::apply([this](const auto&... values) { insertRow(values...); }, row);
+  }
+  _stats.elapsed += Clock::now() - start;
+}
+
+template <typename... TValues>
+void BulkInserter<TValues...>::flush()
+{
+  auto start = Clock::now();
+  commit();
+  _stats.elapsed += Clock::now() - start;
+}
+
+template <typename... TValues>
+void BulkInserter<TValues...>::insertRow(const TValues&... values)
+{
+  if (!_transaction && _db.isAutocommit())
+  {
+    // IMMEDIATE takes the write lock up front, so the batch cannot fail with BUSY halfway through
+    _transaction.emplace(_db, TransactionMode::IMMEDIATE);
+  }
+
+  _insert.execute([]() {}, values...);
+  ++_stats.rows;
+
+  if (++_pending >= _batchSize)
+  {
+    commit();
+  }
+}
+
+template <typename... TValues>
+void BulkInserter<TValues...>::commit()
+{
+  _pending = 0;
+  if (_transaction)
+  {
+    _transaction->commit();
+    _transaction.reset();
+    ++_stats.transactions;
+  }
+}
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace sqlitepp
+{
+
+//! Decides what to do when SQLite reports that the database is locked by another connection.
+//! The policy is consulted from the SQLite busy handler, so it applies equally to
+//! Database::exec and to stepping prepared statements.
+class BusyPolicy
+{
+public:
+  using Duration = std::chrono::microseconds;
+
+  virtual ~BusyPolicy() = default;
+
+  //! Called each time a lock is found contended. attempt is the number of retries already
+  //! done for this lock (0 on first call), elapsed is the time since the lock was first found busy.
+  //! Return the time to sleep before retrying, or std::nullopt to give up and report SQLITE_BUSY.
+  virtual std::optional<Duration> onBusy(unsigned int attempt, Duration elapsed) = 0;
+};
+
+//! Never waits, SQLITE_BUSY is reported to the caller immediately
+class NoWaitBusyPolicy : public BusyPolicy
+{
+public:
+  virtual std::optional<Duration> onBusy(unsigned int /*attempt*/, Duration /*elapsed*/) override { return std::nullopt; }
+};
+
+//! Equivalent of sqlite3_busy_timeout - sleeps using the same schedule SQLite's default
+//! busy handler uses, until the total wait exceeds the timeout
+class BusyTimeoutPolicy : public BusyPolicy
+{
+public:
+  explicit BusyTimeoutPolicy(std::chrono::milliseconds timeout) : _timeout(timeout) {}
+
+  virtual std::optional<Duration> onBusy(unsigned int attempt, Duration elapsed) override;
+private:
+  Duration _timeout;
+};
+
+//! Exponential backoff with random jitter and an optional limit on the number of retries
+class BackoffBusyPolicy : public BusyPolicy
+{
+public:
+  static constexpr unsigned int UNLIMITED_RETRIES = std::numeric_limits<unsigned int>::max();
+
+  //! jitter is the fraction (0-1) of each delay that is randomized, to keep competing writers from waking up in lockstep
+  BackoffBusyPolicy(
+    Duration initialDelay = std::chrono::milliseconds(1),
+    Duration maxDelay = std::chrono::milliseconds(100),
+    unsigned int maxRetries = UNLIMITED_RETRIES,
+    double jitter = 0.5
+  );
+
+  virtual std::optional<Duration> onBusy(unsigned int attempt, Duration elapsed) override;
+
+protected:
+  //! Delay for given attempt including jitter, ignoring the retry limit
+  Duration delayFor(unsigned int attempt) const;
+
+private:
+  Duration _initialDelay;
+  Duration _maxDelay;
+  unsigned int _maxRetries;
+  double _jitter;
+};
+
+//! Exponential backoff that gives up once the total time spent waiting would exceed the deadline
+class DeadlineBusyPolicy : public BackoffBusyPolicy
+{
+public:
+  DeadlineBusyPolicy(
+    Duration deadline,
+    Duration initialDelay = std::chrono::milliseconds(1),
+    Duration maxDelay = std::chrono::milliseconds(100),
+    double jitter = 0.5
+  );
+
+  virtual std::optional<Duration> onBusy(unsigned int attempt, Duration elapsed) override;
+private:
+  Duration _deadline;
+};
+
+//! Counters describing lock contention on a connection
+struct BusyStats
+{
+  // Number of times a lock was found contended for the first time
+  std::uint64_t busyEvents = 0;
+  // Number of retries performed after sleeping
+  std::uint64_t retries = 0;
+  // Number of times the policy gave up and SQLITE_BUSY was reported
+  std::uint64_t giveUps = 0;
+  // Total time spent sleeping in the busy handler
+  std::chrono::nanoseconds waitTime{};
+};
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "Statement.h"
+#include "generic/FixedString.h"
+#include "generic/sql_arity.h"
+
+#include <string>
+
+namespace sqlitepp
+{
+
+//! Statement with the query as a template argument, so that the number of bound values and,
+//! for a plain SELECT, the number of result columns are checked when compiling:
+//! CheckedStatement<"SELECT name, age FROM users WHERE id = ?", std::string, int> stmt;
+//! Since the count is known to match, binding skips the runtime parameter count check.
+template <FixedString TQuery, typename... TResults>
+class CheckedStatement : public Statement<TResults...>
+{
+  using Base = Statement<TResults...>;
+public:
+  static constexpr int PARAMETER_COUNT = sql_arity::countParameters(TQuery.view());
+  static constexpr int COLUMN_COUNT = sql_arity::countResultColumns(TQuery.view());
+
+  static_assert(PARAMETER_COUNT != sql_arity::UNKNOWN, "Query has too many distinct named parameters to be checked");
+  static_assert(sizeof...(TResults) == 0 || COLUMN_COUNT == sql_arity::UNKNOWN || COLUMN_COUNT == (column_count_v<TResults> + ... + 0),
+    "Number of result types does not match the number of columns the query selects");
+
+  CheckedStatement() : Base(std::string(TQuery.view()))
+  {
+    this->checkBindCount = false;
+  }
+
+  template <typename... TValRest>
+  void execute(const typename Base::RowHandler& handler, TValRest&&... values)
+  {
+    static_assert(sizeof...(TValRest) == PARAMETER_COUNT, "Number of bound values does not match the number of query parameters");
+    Base::execute(handler, std::forward<TValRest>(values)...);
+  }
+
+  template <RowInvocable<TResults...> THandler, typename... TValRest>
+  void execute(THandler&& handler, TValRest&&... values)
+  {
+    static_assert(sizeof...(TValRest) == PARAMETER_COUNT, "Number of bound values does not match the number of query parameters");
+    Base::execute(std::forward<THandler>(handler), std::forward<TValRest>(values)...);
+  }
+
+  template <typename... TValRest>
+  Result<TResults...> query(TValRest&&... values)
+  {
+    static_assert(sizeof...(TValRest) == PARAMETER_COUNT, "Number of bound values does not match the number of query parameters");
+    return Base::query(std::forward<TValRest>(values)...);
+  }
+};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "ResultCode.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace sqlitepp
+{
+
+//! How much a WAL checkpoint may wait for, values match SQLITE_CHECKPOINT_*
+enum class CheckpointMode
+{
+  // Copies as many frames as possible without waiting for readers or writers
+  PASSIVE = 0,
+  // Waits for the writer lock and for readers, then copies every frame
+  FULL = 1,
+  // Like FULL, then also waits until readers are done with the WAL so the next writer starts it over
+  RESTART = 2,
+  // Like RESTART, then also truncates the WAL file to zero bytes
+  TRUNCATE = 3,
+};
+
+//! When the background checkpoint scheduler runs and how hard it tries
+struct CheckpointOptions
+{
+  // Uncheckpointed WAL content that triggers a PASSIVE checkpoint right away
+  std::uint64_t passiveBytes = 4 * 1024 * 1024;
+  // WAL content that escalates to RESTART, reached when passive checkpoints cannot keep up with long readers
+  std::uint64_t restartBytes = 64 * 1024 * 1024;
+  // Size of the WAL file that escalates to TRUNCATE to give the disk space back
+  std::uint64_t truncateBytes = 256 * 1024 * 1024;
+  // Time without commits after which any remaining frames are checkpointed with PASSIVE
+  std::chrono::milliseconds idleTime{ 200 };
+  // How often the WAL is looked at when nothing wakes the scheduler earlier
+  std::chrono::milliseconds pollInterval{ 50 };
+  // Longest RESTART and TRUNCATE wait for readers and writers. Writers are blocked meanwhile, so after
+  // one times out only PASSIVE checkpoints run for ten times this long.
+  std::chrono::milliseconds busyTimeout{ 100 };
+};
+
+struct CheckpointStats
+{
+  // Size of the WAL file the last time the scheduler looked at it
+  std::uint64_t walBytes = 0;
+  std::uint64_t maxWalBytes = 0;
+  std::uint64_t passiveCheckpoints = 0;
+  std::uint64_t restartCheckpoints = 0;
+  std::uint64_t truncateCheckpoints = 0;
+  // Checkpoints that got SQLITE_BUSY or could not copy every frame because of active readers
+  std::uint64_t incomplete = 0;
+  // Frames in the WAL after the latest commit on the connection
+  std::uint64_t walFrames = 0;
+  // Checkpoints that failed with anything else than SQLITE_BUSY, lastError holds the latest code
+  std::uint64_t errors = 0;
+  ResultCode lastError = ResultCode::OK;
+  std::chrono::nanoseconds lastDuration{};
+  std::chrono::nanoseconds maxDuration{};
+  std::chrono::nanoseconds totalDuration{};
+
+  std::uint64_t checkpoints() const { return passiveCheckpoints + restartCheckpoints + truncateCheckpoints; }
+};
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace sqlitepp
+{
+
+//! Struct of arrays output of Result::fetchColumns, each column is stored in its own contiguous vector.
+//! A batch can be cleared and refilled, the vectors keep their capacity.
+template<typename ...TColValue>
+struct ColumnBatch
+{
+  std::tuple<std::vector<TColValue>...> columns;
+
+  template<std::size_t TIndex>
+  auto& column() { return std::get<TIndex>(columns); }
+  template<std::size_t TIndex>
+  const auto& column() const { return std::get<TIndex>(columns); }
+
+  std::size_t size() const
+  {
+    if constexpr (sizeof...(TColValue) == 0)
+      return 0;
+    else
+      return std::get<0>(columns).size();
+  }
+
+  void reserve(std::size_t rows)
+  {
+    std::apply([rows](auto&... column) { (column.reserve(rows), ...); }, columns);
+  }
+
+  void clear()
+  {
+    std::apply([](auto&... column) { (column.clear(), ...); }, columns);
+  }
+};
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "Database.h"
+#include "flags.h"
+#include "generic/NoCopy.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sqlitepp
+{
+
+//! Set of connections to one database file in WAL mode: several read-only connections
+//! that can run in parallel and a single writer, matching SQLite's one writer limit.
+//! Connections are handed out as leases and returned when the lease is destroyed. Each connection
+//! keeps its own statement cache, so Statements created on a lease reuse statements prepared by
+//! earlier leases of the same connection. The most recently returned connection is handed out first
+//! to keep its cache warm. Statements must be destroyed before their lease.
+class ConnectionPool : public NoCopy
+{
+public:
+  class Lease : public NoCopy
+  {
+    friend class ConnectionPool;
+  public:
+    Lease(Lease&& other);
+    ~Lease();
+
+    Database& get() const { return *_db; }
+    Database& operator*() const { return *_db; }
+    Database* operator->() const { return _db; }
+
+  private:
+    Lease(ConnectionPool& pool, Database* db, bool writer) : _pool(&pool), _db(db), _writer(writer) {}
+
+    ConnectionPool* _pool;
+    Database* _db;
+    bool _writer;
+  };
+
+  //! Opens the writer (creating the file and switching it to WAL) and readerCount read-only connections.
+  //! Throws SQLiteError for in-memory databases and files that cannot use WAL.
+  ConnectionPool(const std::string& path, std::size_t readerCount);
+
+  //! Blocks until a read-only connection is free
+  Lease acquireReader();
+  //! Blocks until the writer connection is free
+  Lease acquireWriter();
+
+  std::size_t getReaderCount() const { return _readers.size(); }
+
+private:
+  std::vector<std::unique_ptr<Database>> _readers;
+  std::unique_ptr<Database> _writer;
+
+  std::mutex _mutex;
+  std::condition_variable _readerReturned;
+  std::condition_variable _writerReturned;
+  // idle readers, used as a stack
+  std::vector<Database*> _idleReaders;
+  bool _writerIdle = true;
+
+  void giveBack(Database* db, bool writer);
+};
+
+}
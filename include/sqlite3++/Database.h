@@ -1,18 +1,42 @@
 #pragma once
 #include "flags.h"
+#include "OpenOptions.h"
+#include "BusyPolicy.h"
+#include "Checkpoint.h"
+#include "QueryStats.h"
 #include "generic/NoCopy.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 namespace sqlitepp
 {
 
 class RawStatement;
+class Logger;
+
+//! Counters of the prepared statement cache
+struct StatementCacheStats
+{
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  // statements finalized because the cache was full
+  std::uint64_t evictions = 0;
+  // number of times the cache was dropped because of a schema change
+  std::uint64_t invalidations = 0;
+  std::size_t size = 0;
+  std::size_t capacity = 0;
+};
 
 class Database 
 {
   friend class RawStatement;
+  friend class Transaction;
+  friend class Savepoint;
+  friend class BlobStream;
 public:
   enum class ExecResult
   {
@@ -28,10 +52,62 @@ public:
   virtual ~Database();
 
   void open(const char* path, OpenFlags flags = OpenFlags::READWRITE | OpenFlags::CREATE);
+  //! Opens the database and applies the tuning pragmas. If any of them fails or is refused
+  //! (for example WAL on a read-only file), the connection is closed again and the error thrown.
+  //! Page size and journal mode, the settings stored in the file, are applied last, so a refused
+  //! connection setting does not leave the file changed.
+  void open(const char* path, const OpenOptions& options);
 
+  //! Executes SQL without preparing a Statement. If wait is false, the busy policy
+  //! is bypassed and SQLITE_BUSY is reported right away.
   void exec(const char* statement, bool wait = true);
 
   bool isOpen();
+  //! False while a transaction is open on this connection
+  bool isAutocommit() const;
+  //! Rowid of the most recent successful INSERT on this connection
+  std::int64_t getLastInsertRowId() const;
+
+  //! Sets how to wait when the database is locked by another connection. The default
+  //! is BackoffBusyPolicy with unlimited retries. Passing nullptr disables waiting.
+  void setBusyPolicy(std::shared_ptr<BusyPolicy> policy);
+  //! Snapshot of lock contention counters since open or last resetBusyStats
+  BusyStats getBusyStats() const;
+  void resetBusyStats();
+
+  //! Maximum number of idle prepared statements kept for reuse, 0 disables the cache.
+  //! Statements are cached by their SQL text when a Statement is destroyed.
+  void setStatementCacheCapacity(std::size_t capacity);
+  StatementCacheStats getStatementCacheStats() const;
+  //! Finalizes all idle cached statements
+  void clearStatementCache();
+
+  //! Records latency, row counts and sqlite3_stmt_status counters of every statement run on this
+  //! connection, grouped by normalized SQL. Costs a callback per row and per execution while enabled.
+  void setQueryStatsEnabled(bool enabled);
+  bool isQueryStatsEnabled() const;
+  //! Statistics collected so far, the statements with the highest total time first
+  std::vector<QueryStats> getQueryStats() const;
+  void resetQueryStats();
+  //! Writes the statistics of the top statements to the logger at INFO level
+  void logQueryStats(std::size_t limit = 10) const;
+
+  //! Moves WAL checkpoints of this connection's commits to a background thread, so that a commit
+  //! crossing the autocheckpoint threshold no longer pays for the checkpoint. Checkpoints run PASSIVE
+  //! when the WAL grows past options.passiveBytes or the database goes idle, and escalate to
+  //! RESTART and TRUNCATE when readers keep the WAL from being reused. The database must be a file
+  //! in WAL mode. Restarts the scheduler if it is already running.
+  void startCheckpointScheduler(const CheckpointOptions& options = {});
+  //! Stops the background checkpoints and restores the automatic checkpoint setting from before the start
+  void stopCheckpointScheduler();
+  bool isCheckpointSchedulerRunning() const;
+  //! Counters since the scheduler was started, empty when it is not running
+  CheckpointStats getCheckpointStats() const;
+
+  //! Logger used for diagnostics of this connection and its statements. The logger is not
+  //! owned and must outlive the database. nullptr restores the default, which discards everything.
+  void setLogger(Logger* logger);
+  Logger& getLogger() const;
 protected:
   struct Private;
   std::unique_ptr<Private> _private;
@@ -0,0 +1,89 @@
+#pragma once
+#include "flags.h"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace sqlitepp
+{
+
+enum class JournalMode
+{
+  // The default rollback journal, deleted at the end of each transaction. Not called DELETE,
+  // which is a macro in the Windows headers
+  DELETE_JOURNAL,
+  TRUNCATE,
+  PERSIST,
+  // Rollback journal kept in memory, a crash during a transaction may corrupt the database
+  MEMORY,
+  WAL,
+  // No rollback journal at all, ROLLBACK is undefined
+  OFF,
+};
+
+enum class SynchronousMode
+{
+  OFF = 0,
+  // Syncs only at critical moments, safe in WAL mode except for losing the last commits on power loss
+  NORMAL = 1,
+  FULL = 2,
+  EXTRA = 3,
+};
+
+enum class TempStore
+{
+  DEFAULT = 0,
+  FILE = 1,
+  MEMORY = 2,
+};
+
+enum class LockingMode
+{
+  NORMAL,
+  // Locks are kept until the connection closes, saves a lock round trip per transaction.
+  // In WAL mode this also avoids the shared memory file.
+  EXCLUSIVE,
+};
+
+std::string_view toString(JournalMode mode);
+std::string_view toString(LockingMode mode);
+
+//! Performance related pragmas applied when a database is opened. Settings left empty keep
+//! whatever SQLite (or the file) already uses.
+struct TuningProfile
+{
+  std::optional<JournalMode> journalMode;
+  std::optional<SynchronousMode> synchronous;
+  // Bytes of the file accessed through memory mapping, 0 disables it
+  std::optional<std::int64_t> mmapSize;
+  // Page cache size, positive values are pages, negative values KiB
+  std::optional<std::int64_t> cacheSize;
+  std::optional<TempStore> tempStore;
+  // Power of two between 512 and 65536. Only takes effect on a new database file, or on an existing
+  // one after VACUUM, and never once it is in WAL mode
+  std::optional<int> pageSize;
+  // WAL pages that trigger an automatic checkpoint on commit, 0 or less disables them
+  std::optional<int> walAutocheckpoint;
+  std::optional<LockingMode> lockingMode;
+
+  //! Loading a lot of data into a database that can be recreated on failure:
+  //! no syncing, in memory journal, large cache and an exclusive lock
+  static TuningProfile bulkLoad();
+  //! Mostly reads with occasional writes: WAL so readers do not block, a memory map and a larger cache
+  static TuningProfile readHeavy();
+  //! Many small write transactions that must survive power loss: WAL with full sync
+  static TuningProfile durableOltp();
+
+  //! Throws SQLiteError if any setting is out of range
+  void validate() const;
+};
+
+//! Everything Database::open needs besides the path
+struct OpenOptions
+{
+  OpenFlags flags = OpenFlags::READWRITE | OpenFlags::CREATE;
+  TuningProfile tuning;
+};
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace sqlitepp
+{
+
+//! Execution statistics of all statements sharing the same normalized SQL.
+//! Times come from SQLITE_TRACE_PROFILE, which uses the VFS clock - typically millisecond resolution.
+struct QueryStats
+{
+  // Bucket i counts executions faster than 2^i microseconds (and not faster than 2^(i-1)),
+  // the last bucket also holds everything slower
+  static constexpr std::size_t LATENCY_BUCKETS = 24;
+
+  // SQL with literals replaced by ? and whitespace and comments collapsed
+  std::string sql;
+  std::uint64_t executions = 0;
+  std::uint64_t rows = 0;
+  std::chrono::nanoseconds totalTime{};
+  std::chrono::nanoseconds maxTime{};
+  std::array<std::uint64_t, LATENCY_BUCKETS> latencyHistogram{};
+
+  // Totals of sqlite3_stmt_status counters over all executions
+  // Rows stepped through in full table scans, high values suggest a missing index
+  std::uint64_t fullscanSteps = 0;
+  std::uint64_t sorts = 0;
+  // Rows inserted into automatic indexes, which SQLite builds when an index is missing
+  std::uint64_t autoindexRows = 0;
+  std::uint64_t vmSteps = 0;
+  // Number of times the statement was prepared again after a schema change
+  std::uint64_t reprepares = 0;
+
+  std::chrono::nanoseconds averageTime() const { return executions == 0 ? std::chrono::nanoseconds{} : totalTime / static_cast<std::int64_t>(executions); }
+  //! Upper bound of the histogram bucket containing the given quantile (0-1) of executions
+  std::chrono::microseconds latencyQuantile(double quantile) const;
+};
+
+}
@@ -1,19 +1,219 @@
 #pragma once
 #include "ResultRow.h"
+#include "ColumnBatch.h"
+#include "generic/NoCopy.h"
+#include "internal/RawStatement.h"
+#include "traits/ReadTraits.h"
+#include "traits/RowTraits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace sqlitepp
 {
 
+//! Lazy cursor over the rows of an executed statement, returned by Statement::query.
+//! Rows are stepped only when requested. When the cursor is destroyed, including after an
+//! early break from a range based for loop, the statement is reset and can be executed again.
 template<typename ...TColValue>
-class Result
+class Result : public NoCopy
 {
 public:
-  ResultRow<TColValue> NextRow()
+  using Row = ResultRow<TColValue...>;
+
+  class iterator
+  {
+  public:
+    using value_type = Row;
+    using difference_type = std::ptrdiff_t;
+    using iterator_concept = std::input_iterator_tag;
+
+    iterator() = default;
+    explicit iterator(Result* result) : _result(result) {}
+
+    //! Decodes the current row. Unowned values die on the next increment.
+    Row operator*() const { return _result->currentRow(); }
+    iterator& operator++()
+    {
+      _result->consumeRow();
+      _result->ensureRow();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator& it, std::default_sentinel_t) { return it._result == nullptr || it._result->isDone(); }
+
+  private:
+    Result* _result = nullptr;
+  };
+
+  explicit Result(RawStatement& statement) : _statement(&statement) {}
+  Result(Result&& other)
+    : _statement(other._statement)
+    , _rowPending(other._rowPending)
+    , _done(other._done)
+  {
+    other._statement = nullptr;
+  }
+  ~Result()
+  {
+    if (_statement != nullptr)
+    {
+      _statement->Reset();
+    }
+  }
+
+  //! True once the statement returned its last row
+  bool isDone() const { return _done; }
+
+  //! Returns the next row, or std::nullopt when there are no more rows
+  std::optional<Row> NextRow()
+  {
+    ensureRow();
+    if (_done)
+    {
+      return std::nullopt;
+    }
+    std::optional<Row> row(currentRow());
+    consumeRow();
+    return row;
+  }
+
+  iterator begin()
+  {
+    ensureRow();
+    return iterator(this);
+  }
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+
+  //! Appends up to maxRows rows to the batch, one vector per column. Returns the number of rows added,
+  //! less than maxRows only when the statement ran out of rows. Call again to continue the scan.
+  std::size_t fetchColumns(ColumnBatch<TColValue...>& batch, std::size_t maxRows)
+  {
+    return fetchColumnsImpl(maxRows, std::index_sequence_for<TColValue...>{}, [&batch]<std::size_t TIndex>(std::size_t, auto&& value)
+    {
+      std::get<TIndex>(batch.columns).push_back(std::forward<decltype(value)>(value));
+    });
+  }
+
+  //! Reads up to maxRows rows into a new batch
+  ColumnBatch<TColValue...> fetchColumns(std::size_t maxRows)
   {
+    ColumnBatch<TColValue...> batch;
+    batch.reserve(maxRows);
+    fetchColumns(batch, maxRows);
+    return batch;
+  }
+
+  //! Writes rows into caller provided column buffers, stopping when the shortest one is full
+  std::size_t fetchColumns(std::span<TColValue>... columns)
+  {
+    std::size_t maxRows = std::min({ columns.size()... });
+    auto targets = std::forward_as_tuple(columns...);
+    return fetchColumnsImpl(maxRows, std::index_sequence_for<TColValue...>{}, [&targets]<std::size_t TIndex>(std::size_t row, auto&& value)
+    {
+      std::get<TIndex>(targets)[row] = std::forward<decltype(value)>(value);
+    });
+  }
+
+  //! Appends up to maxRows rows of a mapped struct. Each row is decoded into a local and moved in,
+  //! so a failed decode leaves only complete rows in the vector.
+  //! Reserve the vector once up front, then call again to continue the scan.
+  template<MappedRow TRow> requires std::is_same_v<Result, Result<TRow>>
+  std::size_t fetchRows(std::vector<TRow>& rows, std::size_t maxRows)
+  {
+    return fetchRowsImpl<TRow>(maxRows, [&rows](std::size_t, RawStatement::ReadHelper& reader)
+    {
+      TRow row{};
+      ReadRowInto(reader, row);
+      rows.push_back(std::move(row));
+    });
+  }
 
+  //! Overwrites the rows of a caller provided buffer in place, returns how many were filled
+  template<MappedRow TRow> requires std::is_same_v<Result, Result<TRow>>
+  std::size_t fetchRows(std::span<TRow> rows)
+  {
+    return fetchRowsImpl<TRow>(rows.size(), [&rows](std::size_t row, RawStatement::ReadHelper& reader)
+    {
+      ReadRowInto(reader, rows[row]);
+    });
   }
+
 private:
+  RawStatement* _statement;
+  // the statement is positioned on a row that was not handed out yet
+  bool _rowPending = false;
+  bool _done = false;
+
+  void ensureRow()
+  {
+    if (!_rowPending && !_done)
+    {
+      _done = !_statement->Step();
+      _rowPending = !_done;
+    }
+  }
 
+  void consumeRow() { _rowPending = false; }
+
+  Row currentRow()
+  {
+    // a new reader for every row, so that column indexes start at 0
+    RawStatement::ReadHelper reader = _statement->getReader();
+    return Row(reader);
+  }
+
+  template<typename TRow, typename TStore>
+  std::size_t fetchRowsImpl(std::size_t maxRows, TStore&& store)
+  {
+    static_assert(!is_unowned_column_v<TRow>, "Unowned values do not outlive the row, map owning types into fetched rows.");
+
+    std::size_t count = 0;
+    for (; count < maxRows; ++count)
+    {
+      ensureRow();
+      if (_done)
+      {
+        break;
+      }
+      RawStatement::ReadHelper reader = _statement->getReader();
+      store(count, reader);
+      consumeRow();
+    }
+    return count;
+  }
+
+  template<std::size_t... TIndex, typename TStore>
+  std::size_t fetchColumnsImpl(std::size_t maxRows, std::index_sequence<TIndex...>, TStore&& store)
+  {
+    static_assert((!is_unowned_column_v<TColValue> && ...),
+      "Unowned values do not outlive the row, fetch owning types into columns.");
+
+    std::size_t count = 0;
+    for (; count < maxRows; ++count)
+    {
+      ensureRow();
+      if (_done)
+      {
+        break;
+      }
+      RawStatement::ReadHelper reader = _statement->getReader();
+      // the whole row is decoded before any column is stored, so a failed read cannot leave the
+      // columns with different lengths. Braced initialization reads the columns in order
+      std::tuple<TColValue...> values{ ReadTraits<TColValue>::ReadFromStatement(reader)... };
+      (store.template operator()<TIndex>(count, std::move(std::get<TIndex>(values))), ...);
+      consumeRow();
+    }
+    return count;
+  }
 };
 
-}
\ No newline at end of file
+}
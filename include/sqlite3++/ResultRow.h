@@ -1,21 +1,56 @@
 #pragma once
 #include "generic/NoCopy.h"
 #include "generic/templates.h"
+#include "internal/RawStatement.h"
+#include "traits/ReadTraits.h"
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
 
 namespace sqlitepp
 {
 
+//! Values of one result row. Unowned values (StrUnowned, BytesUnowned) are only valid until
+//! the cursor moves to the next row. Supports structured bindings: auto [id, name] = row;
 template<typename ...TColValue>
 class ResultRow : public NoCopy
 {
 public:
+  explicit ResultRow(RawStatement::ReadHelper& reader)
+    // elements of a braced initializer are evaluated in order, so columns are read left to right
+    : _values{ ReadTraits<TColValue>::ReadFromStatement(reader)... }
+  {}
+
+  ResultRow(ResultRow&& other) : _values(std::move(other._values)) {}
+
   template<unsigned int TIndex>
-  get_nth_from_variadric<TIndex, TColValue> GetValue() const
+  const get_nth_from_variadric<TIndex, TColValue...>& GetValue() const
   {
-    return get_nth_from_variadric<TIndex, TColValue>();
+    return std::get<TIndex>(_values);
   }
-  
 
+  template<std::size_t TIndex>
+  auto& get() & { return std::get<TIndex>(_values); }
+  template<std::size_t TIndex>
+  const auto& get() const& { return std::get<TIndex>(_values); }
+  template<std::size_t TIndex>
+  auto&& get() && { return std::get<TIndex>(std::move(_values)); }
+
+  std::tuple<TColValue...>& values() { return _values; }
+
+private:
+  std::tuple<TColValue...> _values;
 };
 
 }
+
+template<typename ...TColValue>
+struct std::tuple_size<sqlitepp::ResultRow<TColValue...>>
+  : std::integral_constant<std::size_t, sizeof...(TColValue)>
+{};
+
+template<std::size_t TIndex, typename ...TColValue>
+struct std::tuple_element<TIndex, sqlitepp::ResultRow<TColValue...>>
+  : std::tuple_element<TIndex, std::tuple<TColValue...>>
+{};
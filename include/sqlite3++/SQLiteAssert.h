@@ -1,5 +1,15 @@
 #pragma once
 
+// When enabled, every bind and column read is checked against the statement.
+// Otherwise the counts are only validated once after the statement is prepared.
+#ifndef SQLITEPP_CHECKED
+#ifdef NDEBUG
+#define SQLITEPP_CHECKED 0
+#else
+#define SQLITEPP_CHECKED 1
+#endif
+#endif
+
 namespace sqlitepp
 {
 
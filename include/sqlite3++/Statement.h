@@ -3,18 +3,28 @@
 #include <memory>
 
 #include "internal/RawStatement.h"
+#include "Result.h"
 #include "traits/ReadTraits.h"
 #include "traits/BindTraits.h"
+#include "traits/RowTraits.h"
 #include "generic/tuple_to_args.h"
 
+#include <concepts>
 #include <functional>
 #include <tuple>
+#include <type_traits>
 
 namespace sqlitepp
 {
 
 class Database;
 
+//! Row handler accepted by the templated Statement::execute, anything callable with the row values
+//! except std::function, which is handled by the RowHandler overload
+template <typename THandler, typename... TResults>
+concept RowInvocable = std::invocable<THandler&, TResults...>
+  && !std::is_same_v<std::remove_cvref_t<THandler>, std::function<bool(TResults...)>>;
+
 template <typename... TResults>
 class Statement
 {
@@ -28,26 +38,52 @@ public:
 
   void Init(Database* db);
 
-  //! Executes the statement using given values
+  //! Executes the statement using given values. The statement is prepared once and
+  //! can be executed any number of times, it is reset after every execution.
+  //! Values are bound by reference without copying, they only need to live until execute returns.
+  template <typename... TValRest>
+  void execute(const RowHandler& handler, TValRest&&... values);
+
+  //! Same as above, but takes any invocable and calls it directly, so the row decoding and
+  //! the handler are inlined in the step loop. The handler may return bool (false stops reading) or void.
+  template <RowInvocable<TResults...> THandler, typename... TValRest>
+  void execute(THandler&& handler, TValRest&&... values);
+
+  //! Executes the statement and returns a cursor that steps through the rows lazily:
+  //! for (auto [id, name] : stmt.query(minId)) { ... }
+  //! Only one cursor may be open per statement, the statement is reset when the cursor is destroyed.
+  //! Temporaries are copied by SQLite because they die before the cursor, other values
+  //! are bound by reference and must outlive it.
   template <typename... TValRest>
-  void execute(const RowHandler& handler, TValRest... values);
+  Result<TResults...> query(TValRest&&... values);
 
 protected:
   //! Binds a value to the statement at a current offset
-  //! It is your responsibility to bind the values in the correct order
+  //! It is your responsibility to bind the values in the correct order.
+  //! Lvalues are bound as STATIC, rvalues with the lifetime given for temporaries.
   template <typename TValue>
-  void bindValue(const TValue& value);
+  void bindValue(TValue&& value, BindLifetime temporaries);
 
   //! Binds values to a prepared statement, after this the statement may be executed
   template <typename... TValRest>
-  void bindValues(TValRest... values);
+  void bindValues(BindLifetime temporaries, TValRest&&... values);
+
+  //! Prepares the statement if needed and binds the values, resets the statement if binding fails
+  template <typename... TValRest>
+  void prepareAndBind(BindLifetime temporaries, TValRest&&... values);
 
   //! Execute the statement and pass each result row to the row handler
   void executePrepared(const RowHandler& rowHandler);
 
+  template <typename THandler>
+  void executePreparedInline(THandler& handler);
+
   //! Provides pointer to the implementation of raw access. Use with caution, or ideally not at all
   RawStatement& getRaw() { return *raw; }
   const RawStatement& getRaw() const { return *raw; }
+
+  // When true, the number of values is checked against the query parameters before binding
+  bool checkBindCount = true;
 private:
   Database* db;
   std::unique_ptr<RawStatement> raw = nullptr;
@@ -59,6 +95,11 @@ Statement<TResults...>::Statement(const std::string& query)
   : db(nullptr)
   , raw(new RawStatement(query))
 {
+  // a Statement<> is allowed to ignore whatever the query returns
+  if constexpr (sizeof...(TResults) > 0)
+  {
+    raw->SetExpectedColumnCount((column_count_v<TResults> + ...));
+  }
 }
 template<typename ...TResults>
 void Statement<TResults...>::Init(Database* db)
@@ -73,27 +114,64 @@ void Statement<TResults...>::Init(Database* db)
 
 template <typename... TResults>
 template <typename TValue>
-void Statement<TResults...>::bindValue(const TValue& value)
+void Statement<TResults...>::bindValue(TValue&& value, BindLifetime temporaries)
 {
-  BindTraits<TValue>::BindValueToStatement(raw->getBinder(), value);
+  // decay turns string literals into const char*
+  BindValue<std::decay_t<TValue>>(raw->getBinder(), value, std::is_lvalue_reference_v<TValue> ? BindLifetime::STATIC : temporaries);
 }
 
 template <typename... TResults>
 template <typename... TValRest>
-void Statement<TResults...>::bindValues(TValRest... values)
+void Statement<TResults...>::bindValues([[maybe_unused]] BindLifetime temporaries, TValRest&&... values)
 {
-  //bindValue(std::forward<TValFirst>(value));
-  (bindValue(std::forward<TValRest>(values)), ...);
+  (bindValue(std::forward<TValRest>(values), temporaries), ...);
 }
 
 template <typename... TResults>
 template <typename... TValRest>
-void Statement<TResults...>::execute(const RowHandler& handler, TValRest... values)
+void Statement<TResults...>::prepareAndBind(BindLifetime temporaries, TValRest&&... values)
 {
   raw->Init();
-  bindValues(values...);
+  if (checkBindCount && static_cast<int>(sizeof...(TValRest)) > raw->getParameterCount())
+  {
+    throw SQLiteError(std::format("Attempted to bind {} values, the query has only {} parameters", sizeof...(TValRest), raw->getParameterCount()));
+  }
+  try
+  {
+    bindValues(temporaries, std::forward<TValRest>(values)...);
+  }
+  catch (...)
+  {
+    // do not leave half of the parameters bound for the next execute
+    raw->Reset();
+    throw;
+  }
+}
+
+template <typename... TResults>
+template <typename... TValRest>
+void Statement<TResults...>::execute(const RowHandler& handler, TValRest&&... values)
+{
+  // temporaries live until the end of the full expression, which includes all the steps
+  prepareAndBind(BindLifetime::STATIC, std::forward<TValRest>(values)...);
   executePrepared(handler);
 }
+
+template <typename... TResults>
+template <typename... TValRest>
+Result<TResults...> Statement<TResults...>::query(TValRest&&... values)
+{
+  prepareAndBind(BindLifetime::TRANSIENT, std::forward<TValRest>(values)...);
+  return Result<TResults...>(*raw);
+}
+
+template <typename... TResults>
+template <RowInvocable<TResults...> THandler, typename... TValRest>
+void Statement<TResults...>::execute(THandler&& handler, TValRest&&... values)
+{
+  prepareAndBind(BindLifetime::STATIC, std::forward<TValRest>(values)...);
+  executePreparedInline(handler);
+}
 //
 //template <typename... TReadTypes>
 //auto readValues(RawStatement::ReadHelper& reader)
@@ -139,8 +217,28 @@ void Statement<TResults...>::executePrepared(const RowHandler& handler)
   });
 }
 
+template <typename... TResults>
+template <typename THandler>
+void Statement<TResults...>::executePreparedInline(THandler& handler)
+{
+  raw->Execute([&handler](RawStatement::ReadHelper& reader) -> bool
+  {
+    // elements of a braced initializer are evaluated in order, so columns are read left to right
+    std::tuple<TResults...> results{ ReadTraits<TResults>::ReadFromStatement(reader)... };
+    if constexpr (std::is_void_v<std::invoke_result_t<THandler&, TResults...>>)
+    {
+      std::apply(handler, std::move(results));
+      return true;
+    }
+    else
+    {
+      return static_cast<bool>(std::apply(handler, std::move(results)));
+    }
+  });
+}
+
 template <>
-void Statement<>::executePrepared(const RowHandler& handler)
+inline void Statement<>::executePrepared(const RowHandler& handler)
 {
   raw->Execute([handler](RawStatement::ReadHelper& reader) -> bool
   {
@@ -0,0 +1,58 @@
+#pragma once
+#include "generic/NoCopy.h"
+
+namespace sqlitepp
+{
+
+class Database;
+
+enum class TransactionMode
+{
+  // Locks are taken when the database is first read or written
+  DEFERRED,
+  // Takes the write lock immediately, use for transactions that will write to avoid
+  // deadlocks between two readers trying to upgrade to a writer
+  IMMEDIATE,
+  // Like IMMEDIATE, in rollback journal mode also prevents other connections from reading
+  EXCLUSIVE,
+};
+
+//! Begins a transaction and rolls it back when destroyed, unless commit was called.
+//! The BEGIN/COMMIT/ROLLBACK statements come from the database's statement cache.
+class Transaction : public NoCopy
+{
+public:
+  explicit Transaction(Database& db, TransactionMode mode = TransactionMode::DEFERRED);
+  ~Transaction();
+
+  void commit();
+  void rollback();
+  //! False after commit or rollback
+  bool isActive() const { return _active; }
+
+private:
+  Database& _db;
+  bool _active = false;
+};
+
+//! Nestable savepoint, works both inside and outside of a Transaction.
+//! Rolled back to and released when destroyed, unless release was called.
+class Savepoint : public NoCopy
+{
+public:
+  explicit Savepoint(Database& db);
+  ~Savepoint();
+
+  //! Keeps the changes made since the savepoint
+  void release();
+  //! Undoes the changes made since the savepoint
+  void rollback();
+  bool isActive() const { return _active; }
+
+private:
+  Database& _db;
+  int _depth;
+  bool _active = false;
+};
+
+}
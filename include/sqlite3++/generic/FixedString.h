@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace sqlitepp
+{
+
+//! String literal usable as a template argument: template <FixedString TText> ...
+template <std::size_t N>
+struct FixedString
+{
+  consteval FixedString(const char (&text)[N])
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      value[i] = text[i];
+  }
+
+  constexpr std::string_view view() const { return { value, N - 1 }; }
+
+  char value[N];
+};
+
+}
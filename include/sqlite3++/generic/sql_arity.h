@@ -0,0 +1,255 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace sqlitepp
+{
+
+// Compile time approximation of how SQLite counts parameters and result columns.
+// Only lexical structure is considered, so the functions can run in constant expressions.
+namespace sql_arity
+{
+
+constexpr int UNKNOWN = -1;
+// named parameters remembered to give repeated names the same index
+constexpr std::size_t MAX_NAMED_PARAMETERS = 64;
+
+constexpr bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+constexpr bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+constexpr bool isIdentifierChar(char c)
+{
+  return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    char x = a[i] >= 'a' && a[i] <= 'z' ? static_cast<char>(a[i] - 'a' + 'A') : a[i];
+    char y = b[i] >= 'a' && b[i] <= 'z' ? static_cast<char>(b[i] - 'a' + 'A') : b[i];
+    if (x != y)
+      return false;
+  }
+  return true;
+}
+
+//! If pos is at a string, quoted identifier or comment, returns the position after it, otherwise pos
+constexpr std::size_t skipLiteral(std::string_view sql, std::size_t pos)
+{
+  char c = sql[pos];
+  char next = pos + 1 < sql.size() ? sql[pos + 1] : '\0';
+  if (c == '-' && next == '-')
+  {
+    std::size_t end = sql.find('\n', pos);
+    return end == std::string_view::npos ? sql.size() : end + 1;
+  }
+  if (c == '/' && next == '*')
+  {
+    std::size_t end = sql.find("*/", pos + 2);
+    return end == std::string_view::npos ? sql.size() : end + 2;
+  }
+  if (c == '\'' || c == '"' || c == '`' || c == '[')
+  {
+    char close = c == '[' ? ']' : c;
+    std::size_t end = pos + 1;
+    while (end < sql.size())
+    {
+      if (sql[end] == close)
+      {
+        // a doubled quote is an escaped quote, brackets cannot be escaped
+        if (close != ']' && end + 1 < sql.size() && sql[end + 1] == close)
+        {
+          end += 2;
+          continue;
+        }
+        return end + 1;
+      }
+      ++end;
+    }
+    return sql.size();
+  }
+  return pos;
+}
+
+constexpr std::size_t skipWord(std::string_view sql, std::size_t pos)
+{
+  while (pos < sql.size() && isIdentifierChar(sql[pos]))
+    ++pos;
+  return pos;
+}
+
+constexpr std::size_t skipSpace(std::string_view sql, std::size_t pos)
+{
+  while (pos < sql.size())
+  {
+    if (isSpace(sql[pos]))
+    {
+      ++pos;
+      continue;
+    }
+    std::size_t after = skipLiteral(sql, pos);
+    // only comments count as space
+    if (after == pos || sql[pos] == '\'' || sql[pos] == '"' || sql[pos] == '`' || sql[pos] == '[')
+      return pos;
+    pos = after;
+  }
+  return pos;
+}
+
+//! Same value as sqlite3_bind_parameter_count: the largest parameter index, where ? takes the
+//! next index, ?NNN takes NNN and each distinct :name, @name or $name takes the next index.
+//! Returns UNKNOWN if there are too many distinct names to track.
+constexpr int countParameters(std::string_view sql)
+{
+  std::array<std::string_view, MAX_NAMED_PARAMETERS> names{};
+  std::size_t nameCount = 0;
+  int largest = 0;
+
+  std::size_t pos = 0;
+  while (pos < sql.size())
+  {
+    std::size_t after = skipLiteral(sql, pos);
+    if (after != pos)
+    {
+      pos = after;
+      continue;
+    }
+
+    char c = sql[pos];
+    if (c == '?')
+    {
+      ++pos;
+      if (pos < sql.size() && isDigit(sql[pos]))
+      {
+        int number = 0;
+        while (pos < sql.size() && isDigit(sql[pos]))
+          number = number * 10 + (sql[pos++] - '0');
+        largest = number > largest ? number : largest;
+      }
+      else
+      {
+        ++largest;
+      }
+    }
+    else if ((c == ':' || c == '@' || c == '$') && pos + 1 < sql.size() && isIdentifierChar(sql[pos + 1]))
+    {
+      std::size_t end = skipWord(sql, pos + 1);
+      std::string_view name = sql.substr(pos, end - pos);
+      pos = end;
+
+      bool seen = false;
+      for (std::size_t i = 0; i < nameCount; ++i)
+        seen = seen || names[i] == name;
+      if (!seen)
+      {
+        if (nameCount == names.size())
+          return UNKNOWN;
+        names[nameCount++] = name;
+        ++largest;
+      }
+    }
+    else if (isIdentifierChar(c))
+    {
+      // keeps a$b or x1 from being read as parameters
+      pos = skipWord(sql, pos);
+    }
+    else
+    {
+      ++pos;
+    }
+  }
+  return largest;
+}
+
+//! Number of result columns of a plain SELECT, counted as the top level commas before FROM.
+//! Returns UNKNOWN for other statements and for result lists containing * or table.*
+constexpr int countResultColumns(std::string_view sql)
+{
+  std::size_t pos = skipSpace(sql, 0);
+  std::size_t end = skipWord(sql, pos);
+  if (!equalsIgnoreCase(sql.substr(pos, end - pos), "SELECT"))
+    return UNKNOWN;
+
+  pos = skipSpace(sql, end);
+  end = skipWord(sql, pos);
+  if (equalsIgnoreCase(sql.substr(pos, end - pos), "DISTINCT") || equalsIgnoreCase(sql.substr(pos, end - pos), "ALL"))
+    pos = end;
+
+  int columns = 1;
+  int depth = 0;
+  // last significant character, '\0' at the start of a result column
+  char previous = '\0';
+  while (pos < sql.size())
+  {
+    pos = skipSpace(sql, pos);
+    if (pos >= sql.size())
+      break;
+
+    std::size_t after = skipLiteral(sql, pos);
+    if (after != pos)
+    {
+      pos = after;
+      previous = 'a';
+      continue;
+    }
+
+    char c = sql[pos];
+    if (isIdentifierChar(c))
+    {
+      end = skipWord(sql, pos);
+      std::string_view word = sql.substr(pos, end - pos);
+      pos = end;
+      previous = 'a';
+      if (depth > 0)
+        continue;
+      for (std::string_view clause : { "FROM", "WHERE", "GROUP", "HAVING", "WINDOW", "ORDER", "LIMIT", "UNION", "INTERSECT", "EXCEPT" })
+      {
+        if (equalsIgnoreCase(word, clause))
+          return columns;
+      }
+      continue;
+    }
+
+    ++pos;
+    if (c == '(')
+    {
+      ++depth;
+    }
+    else if (c == ')')
+    {
+      if (--depth < 0)
+        return UNKNOWN;
+    }
+    else if (depth == 0 && c == ';')
+    {
+      break;
+    }
+    else if (depth == 0 && c == ',')
+    {
+      ++columns;
+      previous = '\0';
+      continue;
+    }
+    else if (depth == 0 && c == '*' && (previous == '\0' || previous == '.'))
+    {
+      return UNKNOWN;
+    }
+    previous = c;
+  }
+  return columns;
+}
+
+}
+
+}
@@ -3,9 +3,13 @@
 #include "../generic/NoCopy.h"
 #include "../generic/StrUnowned.h"
 #include "../exceptions/SQLiteError.h"
+#include "../SQLiteAssert.h"
+#include "../generic/Finally.h"
 
 #include <string>
+#include <string_view>
 #include <memory>
+#include <vector>
 #include "../generic/std_format_polyfill.h"
 #include <functional>
 #include <cstdint>
@@ -15,6 +19,16 @@ namespace sqlitepp
 {
 
 class Database;
+class Logger;
+
+//! How long SQLite may keep pointing at bound string or blob data
+enum class BindLifetime
+{
+  // The data outlives the execution of the statement and is not copied
+  STATIC,
+  // SQLite copies the data before the bind call returns
+  TRANSIENT,
+};
 
 class RawStatement : public NoCopy
 {
@@ -28,9 +42,18 @@ public:
     void Bind(int intval);
     void Bind(std::int64_t intval);
     void Bind(double doubleVal);
-    void Bind(const char* strval);
-    void Bind(const char* strval, std::size_t strLen);
-    void Bind(const void* blobData, std::size_t dataLen);
+    void Bind(const char* strval, BindLifetime lifetime = BindLifetime::STATIC);
+    void Bind(const char* strval, std::size_t strLen, BindLifetime lifetime = BindLifetime::STATIC);
+    void Bind(const void* blobData, std::size_t dataLen, BindLifetime lifetime = BindLifetime::STATIC);
+    //! Binds a blob of `size` zero-filled bytes without allocating it
+    void BindZeroBlob(std::uint64_t size);
+    void BindNull();
+    //! Binds an array for the sqlitepp_array table-valued function, the elements are not copied
+    //! and must stay alive until the statement is done
+    void BindArray(const std::int64_t* values, std::size_t count);
+    void BindArray(const double* values, std::size_t count);
+    void BindArray(const std::string* values, std::size_t count);
+    void BindArray(const std::string_view* values, std::size_t count);
 
     ~BindHelper();
   protected:
@@ -40,7 +63,11 @@ public:
     RawStatement& _stmt;
     int index = 0;
 
-    // Checks if the number of bound params does not exceed number of params in the query
+    template <typename TValue>
+    void bindArray(const TValue* values, std::size_t count, int type);
+
+    // Checks if the number of bound params does not exceed number of params in the query.
+    // Statement checks the count once per execution, this catches direct binder use in checked builds.
     void bindSanityCheck() const;
   };
 
@@ -59,6 +86,10 @@ public:
     double ReadDouble();
     StrUnowned ReadString();
     BytesUnowned ReadBlob();
+    //! True if the next column to be read is NULL, does not advance
+    bool IsNull() const;
+    //! Advances to the next column without reading the current one
+    void Skip();
 
   protected:
     ReadHelper(RawStatement& stmt) : _stmt(stmt) {}
@@ -71,17 +102,43 @@ public:
     void readSanityCheck() const;
   };
 
+  struct ColumnInfo
+  {
+    std::string name;
+    // Type from the table definition, empty for expressions
+    std::string declaredType;
+  };
+
   // Callback to handle each returned row, rows will be supplied as long as they are available and callback returns true
   using RowCallback = std::function<bool(ReadHelper&)>;
 
   RawStatement(const std::string& query, PrepareFlags flags = PrepareFlags::NONE);
   ~RawStatement();
 
+  //! Steps through the result rows. The statement is reset afterwards, so it can be bound and executed again.
   void Execute(const RowCallback& rowHandler);
+  //! Same as above, but the handler is called directly instead of through std::function,
+  //! so the per row work can be inlined into the step loop
+  template <typename TRowHandler>
+  void Execute(TRowHandler&& rowHandler);
+  //! Advances to the next result row. Returns false once all rows were read, throws on error.
+  bool Step();
+  //! Reader for the columns of the current row, starting at the first column
+  ReadHelper getReader() { return ReadHelper(*this); }
+  //! Rewinds the statement and clears all bound values
+  void Reset();
 
   BindHelper& getBinder() { return _binder; }
   void Init();
   void SetDb(Database* db);
+  //! Number of result columns the caller is going to read, checked once in Init. -1 skips the check.
+  void SetExpectedColumnCount(int count) { _expectedColumnCount = count; }
+
+  //! Number of parameters in the query, available after Init
+  int getParameterCount() const { return _bindCount; }
+  //! Column metadata, available after Init
+  int getColumnCount() const { return _columnCount; }
+  const std::vector<ColumnInfo>& getColumns() const { return _columns; }
 protected:
   struct Private;
   std::unique_ptr<Private> _private;
@@ -92,20 +149,59 @@ private:
   bool _isValid = true;
   bool _initCalled = false;
   int _bindCount = 0;
+  int _columnCount = 0;
+  int _expectedColumnCount = -1;
+  std::vector<ColumnInfo> _columns;
   Database* _db;
   std::string _query;
   PrepareFlags _flags;
   BindHelper _binder;
   // set to true when executing, for debugging purposes
   bool _executing = false;
+
+  Logger& logger() const;
 };
 
 inline void RawStatement::BindHelper::bindSanityCheck() const
 {
-  if (index > _stmt._bindCount)
+#if SQLITEPP_CHECKED
+  if (index >= _stmt._bindCount)
+  {
+    throw SQLiteError(std::format("Attempted to bind {} parameters out of max {}", (index + 1), _stmt._bindCount));
+  }
+#endif
+}
+
+template <typename TRowHandler>
+void RawStatement::Execute(TRowHandler&& rowHandler)
+{
+  _executing = true;
+  Finally f{ [this]()
+    {
+      _executing = false;
+      // rewind whether the statement finished, threw or the handler stopped early
+      Reset();
+    }
+  };
+
+  while (Step())
+  {
+    ReadHelper helper(*this);
+    if (!rowHandler(helper))
+    {
+      break;
+    }
+  }
+}
+
+inline void RawStatement::ReadHelper::readSanityCheck() const
+{
+#if SQLITEPP_CHECKED
+  if (_stmt._columnCount <= index)
   {
-    throw SQLiteError(std::format("Attempted to bind {} parameters out of max {}", (index + 1), (_stmt._bindCount + 1)));
+    throw SQLiteError(std::format("Cannot read column #{}, only {} columns available", index, _stmt._columnCount));
   }
+#endif
 }
 
 }
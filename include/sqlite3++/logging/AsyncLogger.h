@@ -0,0 +1,81 @@
+#pragma once
+#include "Logger.h"
+#include "../generic/NoCopy.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace sqlitepp
+{
+
+struct AsyncLoggerStats
+{
+  // Messages handed to the sink
+  std::uint64_t written = 0;
+  // Messages discarded because the queue was full
+  std::uint64_t dropped = 0;
+};
+
+//! Logger that only copies messages into a bounded lock-free queue, a background thread
+//! passes them to the sink in batches and flushes the sink once per batch. Logging never
+//! blocks or allocates: when the queue is full the message is dropped and counted.
+//! Messages are formatted on the calling thread straight into the queue, so that arguments
+//! referring to temporary data stay valid. Longer messages are truncated to MESSAGE_SIZE.
+class AsyncLogger : public Logger, public NoCopy
+{
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+  static constexpr std::size_t MESSAGE_SIZE = 256;
+  static constexpr std::size_t MODULE_NAME_SIZE = 64;
+
+  //! The sink is not owned and must outlive this logger. Capacity is rounded up to a power of two.
+  explicit AsyncLogger(Logger& sink, std::size_t capacity = DEFAULT_CAPACITY);
+  //! Writes out everything queued so far, then stops the thread. No other thread may log meanwhile.
+  virtual ~AsyncLogger() override;
+
+  virtual void write(Level level, std::string_view moduleName, std::string_view message) override;
+  virtual void writeFormatted(Level level, std::string_view moduleName, std::string_view format, std::format_args args) override;
+  //! Both this logger's and the sink's level must allow the message
+  virtual bool isEnabled(Level level) const override { return Logger::isEnabled(level) && _sink.isEnabled(level); }
+  //! Blocks until all messages queued before the call were written and the sink was flushed
+  virtual void flush() override;
+
+  AsyncLoggerStats getStats() const;
+
+private:
+  struct Slot
+  {
+    // Ticket of the producer that may fill the slot, or the ticket + 1 once it is filled
+    std::atomic<std::size_t> sequence;
+    Level level;
+    std::size_t moduleLength;
+    std::size_t messageLength;
+    char moduleName[MODULE_NAME_SIZE];
+    char message[MESSAGE_SIZE];
+  };
+
+  Logger& _sink;
+  std::size_t _mask;
+  std::unique_ptr<Slot[]> _slots;
+
+  // producers claim tickets here, the consumer position is only touched by the thread
+  alignas(64) std::atomic<std::size_t> _enqueuePos{ 0 };
+  alignas(64) std::size_t _dequeuePos = 0;
+  std::atomic<std::uint64_t> _written{ 0 };
+  std::atomic<std::uint64_t> _dropped{ 0 };
+  std::atomic<bool> _stopping{ false };
+  std::thread _worker;
+
+  //! Claims a free slot, nullptr if the queue is full
+  Slot* reserve(Level level, std::string_view moduleName);
+  //! Makes a filled slot visible to the consumer
+  void publish(Slot* slot);
+  //! Writes out all published messages, returns how many there were
+  std::size_t drain();
+  void workerLoop();
+};
+
+}
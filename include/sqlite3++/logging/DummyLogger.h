@@ -7,6 +7,7 @@ namespace sqlitepp
 class DummyLogger : public Logger
 {
 public:
+  DummyLogger() { setLevel(Level::OFF); }
   virtual void write(Level level, std::string_view moduleName, std::string_view message) override {}
 };
 
@@ -5,6 +5,16 @@
 #include <string>
 #include <string_view>
 
+// Messages below this level are compiled out entirely, 0 is TRACE, 5 disables all logging.
+// Release builds drop TRACE by default.
+#ifndef SQLITEPP_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define SQLITEPP_MIN_LOG_LEVEL 1
+#else
+#define SQLITEPP_MIN_LOG_LEVEL 0
+#endif
+#endif
+
 namespace sqlitepp
 {
 
@@ -17,7 +27,9 @@ public:
     INFO,
     WARN,
     ERROR,
-    FATAL
+    FATAL,
+    // Only used as a filter level, to disable all messages
+    OFF
   };
 
   static constexpr const char* LevelStr[] =
@@ -26,10 +38,29 @@ public:
     "INFO",
     "WARN",
     "ERROR",
-    "FATAL"
+    "FATAL",
+    "OFF"
   };
 
+  static constexpr Level MIN_COMPILED_LEVEL = static_cast<Level>(SQLITEPP_MIN_LOG_LEVEL);
+
+  virtual ~Logger() = default;
+
   virtual void write(Level level, std::string_view moduleName, std::string_view message) = 0;
+  //! Formats and writes a message that passed the level filter. Loggers that can format
+  //! without a temporary string override this, by default it calls write.
+  virtual void writeFormatted(Level level, std::string_view moduleName, std::string_view format, std::format_args args)
+  {
+    write(level, moduleName, std::vformat(format, args));
+  }
+  //! Pushes out messages buffered by the logger
+  virtual void flush() {}
+
+  //! Messages below this level are discarded before they are formatted
+  void setLevel(Level level) { _level = level; }
+  Level getLevel() const { return _level; }
+  virtual bool isEnabled(Level level) const { return level >= _level; }
+  static constexpr bool isCompiledIn(Level level) { return level >= MIN_COMPILED_LEVEL; }
 
   static constexpr const char* EMPTY_STR = "";
   // Provides a name of a module (ie. library, class, function)
@@ -37,31 +68,39 @@ public:
   virtual const char* getModuleName() const { return EMPTY_STR; }
 
 protected:
-  template<typename... TArgs>
-  void format_write(Level level, const char* format, TArgs&&... args);
+  template<Level TLevel, typename... TArgs>
+  void format_write(const char* format, TArgs&&... args);
 
 public:
   template<typename... TArgs>
-  void trace(const char* format, TArgs&&... args) { format_write(Level::TRACE, format, args...); }
+  void trace(const char* format, TArgs&&... args) { format_write<Level::TRACE>(format, args...); }
 
   template<typename... TArgs>
-  void info(const char* format, TArgs&&... args) { format_write(Level::INFO, format, args...); }
+  void info(const char* format, TArgs&&... args) { format_write<Level::INFO>(format, args...); }
 
   template<typename... TArgs>
-  void warn(const char* format, TArgs&&... args) { format_write(Level::WARN, format, args...); }
+  void warn(const char* format, TArgs&&... args) { format_write<Level::WARN>(format, args...); }
 
   template<typename... TArgs>
-  void error(const char* format, TArgs&&... args) { format_write(Level::ERROR, format, args...); }
+  void error(const char* format, TArgs&&... args) { format_write<Level::ERROR>(format, args...); }
 
   template<typename... TArgs>
-  void fatal(const char* format, TArgs&&... args) { format_write(Level::FATAL, format, args...); }
+  void fatal(const char* format, TArgs&&... args) { format_write<Level::FATAL>(format, args...); }
+
+private:
+  Level _level = Level::TRACE;
 };
 
-template<typename ...TArgs>
-inline void Logger::format_write(Level level, const char* format, TArgs&& ...args)
+template<Logger::Level TLevel, typename ...TArgs>
+inline void Logger::format_write(const char* format, TArgs&& ...args)
 {
-  std::string msg = std::vformat(format, std::make_format_args(args...));
-  write(level, getModuleName(), msg);
+  if constexpr (isCompiledIn(TLevel))
+  {
+    if (isEnabled(TLevel))
+    {
+      writeFormatted(TLevel, getModuleName(), format, std::make_format_args(args...));
+    }
+  }
 }
 
 }
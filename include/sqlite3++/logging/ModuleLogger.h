@@ -4,7 +4,7 @@
 namespace sqlitepp
 {
 
-std::string&& buildModuleName(Logger* parent, std::string_view current);
+std::string buildModuleName(Logger* parent, std::string_view current);
 
 class ModuleLogger : public Logger
 {
@@ -15,6 +15,12 @@ public:
   {}
 
   virtual void write(Level level, std::string_view moduleName, std::string_view message) override { parent->write(level, moduleName, message); }
+  virtual void writeFormatted(Level level, std::string_view moduleName, std::string_view format, std::format_args args) override
+  {
+    parent->writeFormatted(level, moduleName, format, args);
+  }
+  virtual void flush() override { parent->flush(); }
+  virtual bool isEnabled(Level level) const override { return parent->isEnabled(level); }
   virtual const char* getModuleName() const override { return moduleName.data(); }
 private:
   std::string moduleName;
@@ -22,7 +28,7 @@ private:
 };
 
 
-static inline std::string&& buildModuleName(Logger* parent, std::string_view current)
+inline std::string buildModuleName(Logger* parent, std::string_view current)
 {
   std::string_view parentName{ parent->getModuleName() };
   if (parentName.size() == 0)
@@ -36,7 +42,7 @@ static inline std::string&& buildModuleName(Logger* parent, std::string_view cur
     res.append(parentName);
     res.append(".");
     res.append(current);
-    return std::move(res);
+    return res;
   }
 }
 
@@ -35,11 +35,13 @@ namespace sqlitepp
 class OstreamLogger : public Logger
 {
 public:
+  //! Only ERROR and FATAL flush the stream right away, call flush to push out the rest
   virtual void write(Level level, std::string_view moduleName, std::string_view message) override;
+  virtual void flush() override { getStream().flush(); }
   virtual std::ostream& getStream() = 0;
 };
 
-void OstreamLogger::write(Level level, std::string_view moduleName, std::string_view message)
+inline void OstreamLogger::write(Level level, std::string_view moduleName, std::string_view message)
 {
   using Clock = std::chrono::system_clock;
 
@@ -56,8 +58,12 @@ void OstreamLogger::write(Level level, std::string_view moduleName, std::string_
     << Logger::LevelStr[(std::size_t)level] << " "
     << moduleName << " "
     << message
-    << std::endl;
-};
+    << '\n';
+  if (level >= Level::ERROR)
+  {
+    getStream().flush();
+  }
+}
 
 class OstreamLoggerBorrowed : public OstreamLogger
 {
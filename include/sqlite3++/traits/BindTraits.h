@@ -1,12 +1,18 @@
 #pragma once
 #include "internal/RawStatement.h"
+#include "exceptions/SQLiteError.h"
 #include "generic/TemplateAssertFalse.h"
 
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <variant>
 
 namespace sqlitepp
 {
@@ -20,18 +26,32 @@ struct BindTraits
   }
 };
 
+//! Binds a value using its BindTraits. Traits of values that SQLite reads through a pointer
+//! accept a BindLifetime as a third argument, the lifetime is ignored for the others.
+template <typename TBind>
+void BindValue(RawStatement::BindHelper& binder, const TBind& value, BindLifetime lifetime)
+{
+  if constexpr (requires { BindTraits<TBind>::BindValueToStatement(binder, value, lifetime); })
+    BindTraits<TBind>::BindValueToStatement(binder, value, lifetime);
+  else
+    BindTraits<TBind>::BindValueToStatement(binder, value);
+}
+
 template <>
 struct BindTraits<std::string>
 {
-  static void BindValueToStatement(RawStatement::BindHelper& binder, const std::string& value) { binder.Bind(value.data(), value.size()); }
+  static void BindValueToStatement(RawStatement::BindHelper& binder, const std::string& value, BindLifetime lifetime = BindLifetime::STATIC)
+  {
+    binder.Bind(value.data(), value.size(), lifetime);
+  }
 };
 
 template <>
 struct BindTraits<std::string_view>
 {
-  static void BindValueToStatement(RawStatement::BindHelper& binder, const std::string_view& value)
+  static void BindValueToStatement(RawStatement::BindHelper& binder, const std::string_view& value, BindLifetime lifetime = BindLifetime::STATIC)
   {
-    binder.Bind(value.data(), value.size());
+    binder.Bind(value.data(), value.size(), lifetime);
   }
 };
 
@@ -56,7 +76,38 @@ struct BindTraits<double>
 template <>
 struct BindTraits<const char*>
 {
-  static void BindValueToStatement(RawStatement::BindHelper& binder, const char* value) { binder.Bind(value); }
+  static void BindValueToStatement(RawStatement::BindHelper& binder, const char* value, BindLifetime lifetime = BindLifetime::STATIC) { binder.Bind(value, lifetime); }
+};
+
+template <>
+struct BindTraits<std::nullptr_t>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, std::nullptr_t) { binder.BindNull(); }
+};
+
+template <>
+struct BindTraits<std::monostate>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, std::monostate) { binder.BindNull(); }
+};
+
+template <>
+struct BindTraits<std::nullopt_t>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, std::nullopt_t) { binder.BindNull(); }
+};
+
+//! Empty optional binds NULL
+template <typename TBind>
+struct BindTraits<std::optional<TBind>>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, const std::optional<TBind>& value, BindLifetime lifetime = BindLifetime::STATIC)
+  {
+    if (value)
+      BindValue(binder, *value, lifetime);
+    else
+      binder.BindNull();
+  }
 };
 
 struct BindVoidData
@@ -69,8 +120,79 @@ struct BindVoidData
 template <>
 struct BindTraits<BindVoidData>
 {
-  static void BindValueToStatement(RawStatement::BindHelper& binder, const BindVoidData& value) { binder.Bind(value.data, value.size); }
+  static void BindValueToStatement(RawStatement::BindHelper& binder, const BindVoidData& value, BindLifetime lifetime = BindLifetime::STATIC)
+  {
+    binder.Bind(value.data, value.size, lifetime);
+  }
+};
+
+//! Blob of given size filled with zeros, SQLite does not allocate it in memory.
+//! Reserves space for a value that is then written in chunks with BlobStream.
+struct ZeroBlob
+{
+  explicit ZeroBlob(std::uint64_t size) : size(size) {}
+  std::uint64_t size;
 };
 
+template <>
+struct BindTraits<ZeroBlob>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, const ZeroBlob& value) { binder.BindZeroBlob(value.size); }
+};
+
+
+//! Name of the table-valued function that reads a bound array, one row per element:
+//! SELECT * FROM items WHERE id IN sqlitepp_array(?)
+//! Bind std::span<const T> or any contiguous container of T to the parameter, T being std::int64_t,
+//! double, std::string or std::string_view. Elements are not copied and must outlive the execution.
+constexpr const char* ARRAY_FUNCTION = "sqlitepp_array";
+
+template <>
+struct BindTraits<std::span<const std::int64_t>>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, std::span<const std::int64_t> value) { binder.BindArray(value.data(), value.size()); }
+};
+
+template <>
+struct BindTraits<std::span<const double>>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, std::span<const double> value) { binder.BindArray(value.data(), value.size()); }
+};
+
+template <>
+struct BindTraits<std::span<const std::string>>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, std::span<const std::string> value) { binder.BindArray(value.data(), value.size()); }
+};
+
+template <>
+struct BindTraits<std::span<const std::string_view>>
+{
+  static void BindValueToStatement(RawStatement::BindHelper& binder, std::span<const std::string_view> value) { binder.BindArray(value.data(), value.size()); }
+};
+
+template <typename TElement>
+concept ArrayElement = std::is_same_v<TElement, std::int64_t> || std::is_same_v<TElement, double>
+  || std::is_same_v<TElement, std::string> || std::is_same_v<TElement, std::string_view>;
+
+//! Containers like std::vector or std::span<T> bind through the std::span<const T> traits above
+template <typename TContainer>
+  requires std::ranges::contiguous_range<const TContainer>
+    && ArrayElement<std::ranges::range_value_t<TContainer>>
+    && std::is_convertible_v<const TContainer&, std::span<const std::ranges::range_value_t<TContainer>>>
+struct BindTraits<TContainer>
+{
+  using Span = std::span<const std::ranges::range_value_t<TContainer>>;
+
+  static void BindValueToStatement(RawStatement::BindHelper& binder, const TContainer& value, BindLifetime lifetime = BindLifetime::STATIC)
+  {
+    // a temporary container would be gone before the statement reads its elements
+    if (lifetime == BindLifetime::TRANSIENT && !std::ranges::borrowed_range<TContainer>)
+    {
+      throw SQLiteError("Arrays are bound without copying, a temporary container cannot be bound to a query");
+    }
+    BindTraits<Span>::BindValueToStatement(binder, Span(value));
+  }
+};
 
-}
\ No newline at end of file
+}
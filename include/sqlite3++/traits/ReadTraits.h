@@ -6,7 +6,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
 
 namespace sqlitepp
 {
@@ -66,4 +71,101 @@ struct ReadTraits<BytesUnowned>
   }
 };
 
+//! Zero-copy view valid until the cursor moves to the next row
+template<>
+struct ReadTraits<std::string_view>
+{
+  static std::string_view ReadFromStatement(RawStatement::ReadHelper& reader)
+  {
+    StrUnowned str = reader.ReadString();
+    return { str.data(), str.size() };
+  }
+};
+
+//! Zero-copy view valid until the cursor moves to the next row
+template<>
+struct ReadTraits<std::span<const std::byte>>
+{
+  static std::span<const std::byte> ReadFromStatement(RawStatement::ReadHelper& reader)
+  {
+    BytesUnowned blob = reader.ReadBlob();
+    return { reinterpret_cast<const std::byte*>(blob.data()), blob.size() };
+  }
+};
+
+template<>
+struct ReadTraits<std::string>
+{
+  static std::string ReadFromStatement(RawStatement::ReadHelper& reader)
+  {
+    StrUnowned str = reader.ReadString();
+    if (str.size() == 0)
+      return {};
+    return std::string(str.data(), str.size());
+  }
+};
+
+template<>
+struct ReadTraits<std::vector<std::byte>>
+{
+  static std::vector<std::byte> ReadFromStatement(RawStatement::ReadHelper& reader)
+  {
+    BytesUnowned blob = reader.ReadBlob();
+    const std::byte* data = reinterpret_cast<const std::byte*>(blob.data());
+    if (blob.size() == 0)
+      return {};
+    return std::vector<std::byte>(data, data + blob.size());
+  }
+};
+
+//! NULL reads as std::nullopt, other values are read as TRead
+template <typename TRead>
+struct ReadTraits<std::optional<TRead>>
+{
+  static std::optional<TRead> ReadFromStatement(RawStatement::ReadHelper& reader)
+  {
+    if (reader.IsNull())
+    {
+      reader.Skip();
+      return std::nullopt;
+    }
+    return ReadTraits<TRead>::ReadFromStatement(reader);
+  }
+};
+
+//! Placeholder for a column whose value is not needed, the column is skipped
+template<>
+struct ReadTraits<std::monostate>
+{
+  static std::monostate ReadFromStatement(RawStatement::ReadHelper& reader)
+  {
+    reader.Skip();
+    return {};
+  }
+};
+
+template<>
+struct ReadTraits<std::nullptr_t>
+{
+  static std::nullptr_t ReadFromStatement(RawStatement::ReadHelper& reader)
+  {
+    reader.Skip();
+    return nullptr;
+  }
+};
+
+//! True for column types that point into SQLite memory and are only valid until the next row
+template <typename TRead>
+inline constexpr bool is_unowned_column_v = false;
+template <>
+inline constexpr bool is_unowned_column_v<StrUnowned> = true;
+template <>
+inline constexpr bool is_unowned_column_v<BytesUnowned> = true;
+template <>
+inline constexpr bool is_unowned_column_v<std::string_view> = true;
+template <>
+inline constexpr bool is_unowned_column_v<std::span<const std::byte>> = true;
+template <typename TRead>
+inline constexpr bool is_unowned_column_v<std::optional<TRead>> = is_unowned_column_v<TRead>;
+
 }
@@ -0,0 +1,62 @@
+#pragma once
+#include "../internal/RawStatement.h"
+#include "ReadTraits.h"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace sqlitepp
+{
+
+//! Maps result columns to members of a struct, in column order. Specialize it for a row type
+//! before the first Statement using it:
+//! template <>
+//! struct sqlitepp::RowTraits<User>
+//! {
+//!   static constexpr auto fields = std::make_tuple(&User::id, &User::name, &User::email);
+//! };
+//! Statement<User> then reads every row straight into a User.
+template <typename TRow>
+struct RowTraits
+{
+};
+
+template <typename TRow>
+concept MappedRow = requires { RowTraits<TRow>::fields; };
+
+//! Reads the columns of the current row into the mapped members of an existing row
+template <MappedRow TRow>
+void ReadRowInto(RawStatement::ReadHelper& reader, TRow& row)
+{
+  std::apply([&reader, &row](auto... fields)
+  {
+    // the comma fold keeps the columns in order
+    ((row.*fields = ReadTraits<std::remove_cvref_t<decltype(row.*fields)>>::ReadFromStatement(reader)), ...);
+  }, RowTraits<TRow>::fields);
+}
+
+template <MappedRow TRow>
+struct ReadTraits<TRow>
+{
+  static TRow ReadFromStatement(RawStatement::ReadHelper& reader)
+  {
+    TRow row{};
+    ReadRowInto(reader, row);
+    return row;
+  }
+};
+
+//! Number of result columns a value of this type is read from
+template <typename TRead>
+inline constexpr int column_count_v = 1;
+template <MappedRow TRow>
+inline constexpr int column_count_v<TRow> = static_cast<int>(std::tuple_size_v<std::remove_cvref_t<decltype(RowTraits<TRow>::fields)>>);
+
+template <MappedRow TRow>
+inline constexpr bool is_unowned_column_v<TRow> = std::apply([](auto... fields)
+{
+  return (is_unowned_column_v<std::remove_cvref_t<decltype(std::declval<TRow&>().*fields)>> || ...);
+}, RowTraits<TRow>::fields);
+
+}
@@ -0,0 +1,38 @@
+# Builds the benchmark once per sqlite3.c build profile and runs both, so their outputs can be compared.
+# usage: cmake [-DPROFILES="DEFAULT;PERFORMANCE"] [-DFILTER=profile_] [-DMIN_MS=500] -P scripts/compare_sqlite_profiles.cmake
+# Build directories are created next to the sources as _profile_<name>.
+
+if(NOT DEFINED PROFILES)
+  set(PROFILES DEFAULT PERFORMANCE)
+endif()
+if(NOT DEFINED FILTER)
+  set(FILTER "")
+endif()
+if(NOT DEFINED MIN_MS)
+  set(MIN_MS 500)
+endif()
+
+get_filename_component(source_dir "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+
+foreach(profile IN LISTS PROFILES)
+  set(build_dir "${source_dir}/_profile_${profile}")
+  message(STATUS "Building profile ${profile} in ${build_dir}")
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} -S ${source_dir} -B ${build_dir} -DCMAKE_BUILD_TYPE=Release
+      -DSQLITEPP_BUILD_BENCH=ON -DSQLITEPP_SQLITE_PROFILE=${profile}
+    RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Configuring profile ${profile} failed")
+  endif()
+  execute_process(COMMAND ${CMAKE_COMMAND} --build ${build_dir} --config Release --target sqlite3++_bench RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Building profile ${profile} failed")
+  endif()
+endforeach()
+
+foreach(profile IN LISTS PROFILES)
+  set(build_dir "${source_dir}/_profile_${profile}")
+  find_program(bench_${profile} sqlite3++_bench PATHS ${build_dir} ${build_dir}/Release NO_DEFAULT_PATH)
+  message(STATUS "==== ${profile} ====")
+  execute_process(COMMAND ${bench_${profile}} "${FILTER}" ${MIN_MS})
+endforeach()
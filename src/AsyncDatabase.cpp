@@ -0,0 +1,95 @@
+#include "AsyncDatabase.h"
+#include "exceptions/SQLiteError.h"
+
+#include <algorithm>
+
+namespace sqlitepp
+{
+
+AsyncDatabase::AsyncDatabase(const std::string& path, OpenFlags flags, std::size_t queueCapacity)
+  : _capacity(std::max<std::size_t>(queueCapacity, 1))
+{
+  // opened on the calling thread so that errors are reported from the constructor
+  _db.open(path.c_str(), flags);
+  _worker = std::thread([this]() { workerLoop(); });
+}
+
+AsyncDatabase::~AsyncDatabase()
+{
+  {
+    std::lock_guard lock(_mutex);
+    _stopping = true;
+  }
+  _notEmpty.notify_all();
+  _worker.join();
+}
+
+std::future<void> AsyncDatabase::exec(std::string sql)
+{
+  return submit([sql = std::move(sql)](Database& db)
+  {
+    db.exec(sql.c_str());
+  });
+}
+
+AsyncQueueStats AsyncDatabase::getStats() const
+{
+  std::lock_guard lock(_mutex);
+  AsyncQueueStats stats = _stats;
+  stats.depth = _queue.size();
+  return stats;
+}
+
+bool AsyncDatabase::enqueue(std::unique_ptr<Task>& task, bool block)
+{
+  {
+    std::unique_lock lock(_mutex);
+    if (_queue.size() >= _capacity)
+    {
+      if (!block)
+      {
+        ++_stats.rejected;
+        return false;
+      }
+      // only the worker makes room in the queue, it would wait for itself forever
+      if (std::this_thread::get_id() == _worker.get_id())
+      {
+        throw SQLiteError("Async database queue is full, work submitted from its own thread cannot wait for room");
+      }
+      _notFull.wait(lock, [this]() { return _queue.size() < _capacity; });
+    }
+    _queue.push_back(std::move(task));
+    ++_stats.submitted;
+    _stats.maxDepth = std::max(_stats.maxDepth, _queue.size());
+  }
+  _notEmpty.notify_one();
+  return true;
+}
+
+void AsyncDatabase::workerLoop()
+{
+  while (true)
+  {
+    std::unique_ptr<Task> task;
+    {
+      std::unique_lock lock(_mutex);
+      _notEmpty.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+      // queued work is still finished when stopping
+      if (_queue.empty())
+      {
+        return;
+      }
+      task = std::move(_queue.front());
+      _queue.pop_front();
+    }
+    _notFull.notify_one();
+
+    // tasks report their own exceptions through the future or awaitable
+    task->run(_db);
+
+    std::lock_guard lock(_mutex);
+    ++_stats.completed;
+  }
+}
+
+}
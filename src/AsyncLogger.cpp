@@ -0,0 +1,211 @@
+#include "logging/AsyncLogger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace sqlitepp
+{
+
+namespace
+{
+// Output iterator that fills a fixed buffer and silently drops whatever does not fit
+class TruncatingWriter
+{
+public:
+  using difference_type = std::ptrdiff_t;
+
+  TruncatingWriter(char* begin, char* end) : _pos(begin), _end(end) {}
+
+  TruncatingWriter& operator=(char c)
+  {
+    if (_pos != _end)
+      *_pos++ = c;
+    return *this;
+  }
+  TruncatingWriter& operator*() { return *this; }
+  TruncatingWriter& operator++() { return *this; }
+  TruncatingWriter& operator++(int) { return *this; }
+
+  char* position() const { return _pos; }
+
+private:
+  char* _pos;
+  char* _end;
+};
+
+std::size_t roundUpToPowerOfTwo(std::size_t value)
+{
+  std::size_t result = 2;
+  while (result < value)
+    result <<= 1;
+  return result;
+}
+
+constexpr std::chrono::microseconds MIN_IDLE_SLEEP{ 50 };
+constexpr std::chrono::microseconds MAX_IDLE_SLEEP{ 5000 };
+}
+
+AsyncLogger::AsyncLogger(Logger& sink, std::size_t capacity)
+  : _sink(sink)
+  , _mask(roundUpToPowerOfTwo(capacity) - 1)
+  , _slots(new Slot[_mask + 1])
+{
+  for (std::size_t i = 0; i <= _mask; ++i)
+  {
+    _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  _worker = std::thread(&AsyncLogger::workerLoop, this);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+  _stopping.store(true, std::memory_order_release);
+  _worker.join();
+}
+
+AsyncLogger::Slot* AsyncLogger::reserve(Level level, std::string_view moduleName)
+{
+  // bounded MPMC queue from Dmitry Vyukov, used with a single consumer
+  std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+  Slot* slot = nullptr;
+  for (;;)
+  {
+    slot = &_slots[pos & _mask];
+    std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0)
+    {
+      if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0)
+    {
+      // the consumer has not freed this slot yet, the queue is full
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    else
+    {
+      pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->level = level;
+  slot->moduleLength = std::min(moduleName.size(), MODULE_NAME_SIZE);
+  std::memcpy(slot->moduleName, moduleName.data(), slot->moduleLength);
+  return slot;
+}
+
+void AsyncLogger::publish(Slot* slot)
+{
+  std::size_t ticket = slot->sequence.load(std::memory_order_relaxed);
+  slot->sequence.store(ticket + 1, std::memory_order_release);
+}
+
+void AsyncLogger::write(Level level, std::string_view moduleName, std::string_view message)
+{
+  Slot* slot = reserve(level, moduleName);
+  if (slot == nullptr)
+    return;
+  slot->messageLength = std::min(message.size(), MESSAGE_SIZE);
+  std::memcpy(slot->message, message.data(), slot->messageLength);
+  publish(slot);
+}
+
+void AsyncLogger::writeFormatted(Level level, std::string_view moduleName, std::string_view format, std::format_args args)
+{
+  Slot* slot = reserve(level, moduleName);
+  if (slot == nullptr)
+    return;
+  slot->messageLength = 0;
+  // the slot is already claimed, it must be published even if formatting fails
+  try
+  {
+    TruncatingWriter end = std::vformat_to(TruncatingWriter(slot->message, slot->message + MESSAGE_SIZE), format, args);
+    slot->messageLength = static_cast<std::size_t>(end.position() - slot->message);
+  }
+  catch (...)
+  {
+    publish(slot);
+    throw;
+  }
+  publish(slot);
+}
+
+std::size_t AsyncLogger::drain()
+{
+  std::size_t count = 0;
+  for (;;)
+  {
+    Slot& slot = _slots[_dequeuePos & _mask];
+    if (slot.sequence.load(std::memory_order_acquire) != _dequeuePos + 1)
+      break;
+
+    try
+    {
+      _sink.write(slot.level, { slot.moduleName, slot.moduleLength }, { slot.message, slot.messageLength });
+    }
+    catch (...)
+    {
+      // there is nobody to report a failing sink to on this thread, the message is lost
+    }
+    // hand the slot to the producer that is one lap ahead
+    slot.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+    ++_dequeuePos;
+    ++count;
+  }
+  if (count > 0)
+  {
+    try
+    {
+      _sink.flush();
+    }
+    catch (...)
+    {
+    }
+    _written.fetch_add(count, std::memory_order_release);
+  }
+  return count;
+}
+
+void AsyncLogger::workerLoop()
+{
+  // the thread polls instead of waiting on a condition variable, so producers never make a system call
+  auto idleSleep = MIN_IDLE_SLEEP;
+  for (;;)
+  {
+    if (drain() > 0)
+    {
+      idleSleep = MIN_IDLE_SLEEP;
+      continue;
+    }
+    if (_stopping.load(std::memory_order_acquire))
+    {
+      drain();
+      return;
+    }
+    std::this_thread::sleep_for(idleSleep);
+    idleSleep = std::min(idleSleep * 2, MAX_IDLE_SLEEP);
+  }
+}
+
+void AsyncLogger::flush()
+{
+  // every claimed ticket is eventually published, even when formatting throws
+  std::uint64_t target = _enqueuePos.load(std::memory_order_acquire);
+  while (_written.load(std::memory_order_acquire) < target)
+  {
+    std::this_thread::sleep_for(MIN_IDLE_SLEEP);
+  }
+}
+
+AsyncLoggerStats AsyncLogger::getStats() const
+{
+  AsyncLoggerStats stats;
+  stats.written = _written.load(std::memory_order_relaxed);
+  stats.dropped = _dropped.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}
@@ -0,0 +1,295 @@
+#include "BlobStream.h"
+#include "Database.h"
+#include "exceptions/SQLiteError.h"
+#include "private/Database_Private.h"
+#include "generic/std_format_polyfill.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "sqlite3.h"
+
+namespace sqlitepp
+{
+
+struct BlobStream::Private
+{
+  sqlite3* db = nullptr;
+  sqlite3_blob* blob = nullptr;
+};
+
+namespace
+{
+// the incremental blob API takes int sizes and offsets
+void checkRange(std::size_t size, std::size_t offset)
+{
+  constexpr std::size_t INT_LIMIT = static_cast<std::size_t>(std::numeric_limits<int>::max());
+  if (size > INT_LIMIT || offset > INT_LIMIT - size)
+  {
+    throw SQLiteError(std::format("Blob range of {} bytes at offset {} exceeds int size", size, offset));
+  }
+}
+}
+
+BlobStream::BlobStream(Database& db, const std::string& table, const std::string& column, std::int64_t rowid, bool writable, const std::string& schema)
+  : _private(new Private)
+  , _writable(writable)
+{
+  _private->db = db._private->db;
+  int result = sqlite3_blob_open(_private->db, schema.c_str(), table.c_str(), column.c_str(), rowid, writable ? 1 : 0, &_private->blob);
+  if (result != SQLITE_OK)
+  {
+    std::string errorMsg = sqlite3_errmsg(_private->db);
+    sqlite3_blob_close(_private->blob);
+    _private->blob = nullptr;
+    throw SQLiteCodedError(std::format("Cannot open blob {}.{} in row {}: {}", table, column, rowid, errorMsg), static_cast<ResultCode>(result));
+  }
+}
+
+BlobStream::BlobStream(BlobStream&& other)
+  : _private(new Private(*other._private))
+  , _writable(other._writable)
+{
+  other._private->blob = nullptr;
+}
+
+BlobStream::~BlobStream()
+{
+  sqlite3_blob_close(_private->blob);
+}
+
+void BlobStream::reopen(std::int64_t rowid)
+{
+  if (_private->blob == nullptr)
+  {
+    throw SQLiteError("Cannot reopen a closed blob");
+  }
+  int result = sqlite3_blob_reopen(_private->blob, rowid);
+  if (result != SQLITE_OK)
+  {
+    // the handle stays allocated but aborted, every further access fails until reopen succeeds
+    throw SQLiteCodedError(std::format("Cannot reopen blob in row {}: {}", rowid, sqlite3_errmsg(_private->db)), static_cast<ResultCode>(result));
+  }
+}
+
+void BlobStream::close()
+{
+  sqlite3_blob* blob = _private->blob;
+  _private->blob = nullptr;
+  int result = sqlite3_blob_close(blob);
+  if (result != SQLITE_OK)
+  {
+    throw SQLiteCodedError(std::string("Error closing blob: ") + sqlite3_errmsg(_private->db), static_cast<ResultCode>(result));
+  }
+}
+
+bool BlobStream::isOpen() const
+{
+  return _private->blob != nullptr;
+}
+
+std::size_t BlobStream::size() const
+{
+  return static_cast<std::size_t>(sqlite3_blob_bytes(_private->blob));
+}
+
+void BlobStream::read(void* buffer, std::size_t size, std::size_t offset) const
+{
+  checkRange(size, offset);
+  int result = sqlite3_blob_read(_private->blob, buffer, static_cast<int>(size), static_cast<int>(offset));
+  if (result != SQLITE_OK)
+  {
+    throw SQLiteCodedError(std::format("Cannot read {} bytes at offset {} from blob: {}", size, offset, sqlite3_errmsg(_private->db)), static_cast<ResultCode>(result));
+  }
+}
+
+void BlobStream::write(const void* buffer, std::size_t size, std::size_t offset)
+{
+  checkRange(size, offset);
+  int result = sqlite3_blob_write(_private->blob, buffer, static_cast<int>(size), static_cast<int>(offset));
+  if (result != SQLITE_OK)
+  {
+    throw SQLiteCodedError(std::format("Cannot write {} bytes at offset {} to blob: {}", size, offset, sqlite3_errmsg(_private->db)), static_cast<ResultCode>(result));
+  }
+}
+
+BlobStreamBuf::BlobStreamBuf(BlobStream& blob, std::size_t chunkSize)
+  : _blob(blob)
+  , _buffer(std::max<std::size_t>(chunkSize, 1))
+{}
+
+BlobStreamBuf::~BlobStreamBuf()
+{
+  try
+  {
+    flushWrites();
+  }
+  catch (const SQLiteError&)
+  {
+  }
+}
+
+std::size_t BlobStreamBuf::position() const
+{
+  // only one of the areas is in use at a time
+  if (pbase() != nullptr)
+    return _bufferOffset + static_cast<std::size_t>(pptr() - pbase());
+  if (eback() != nullptr)
+    return _bufferOffset + static_cast<std::size_t>(gptr() - eback());
+  return _bufferOffset;
+}
+
+void BlobStreamBuf::flushWrites()
+{
+  if (pbase() == nullptr)
+    return;
+
+  std::size_t pending = static_cast<std::size_t>(pptr() - pbase());
+  if (pending > 0)
+  {
+    _blob.write(pbase(), pending, _bufferOffset);
+  }
+  _bufferOffset += pending;
+  setp(nullptr, nullptr);
+}
+
+BlobStreamBuf::int_type BlobStreamBuf::underflow()
+{
+  flushWrites();
+  std::size_t pos = position();
+  std::size_t blobSize = _blob.size();
+  if (pos >= blobSize)
+  {
+    return traits_type::eof();
+  }
+
+  std::size_t count = std::min(_buffer.size(), blobSize - pos);
+  _blob.read(_buffer.data(), count, pos);
+  _bufferOffset = pos;
+  setg(_buffer.data(), _buffer.data(), _buffer.data() + count);
+  return traits_type::to_int_type(*gptr());
+}
+
+BlobStreamBuf::int_type BlobStreamBuf::overflow(int_type ch)
+{
+  if (!_blob.isWritable())
+  {
+    return traits_type::eof();
+  }
+
+  std::size_t pos = position();
+  flushWrites();
+  std::size_t blobSize = _blob.size();
+  if (pos >= blobSize)
+  {
+    return traits_type::eof();
+  }
+
+  std::size_t count = std::min(_buffer.size(), blobSize - pos);
+  _bufferOffset = pos;
+  setg(nullptr, nullptr, nullptr);
+  setp(_buffer.data(), _buffer.data() + count);
+  if (!traits_type::eq_int_type(ch, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+int BlobStreamBuf::sync()
+{
+  flushWrites();
+  return 0;
+}
+
+std::streamsize BlobStreamBuf::xsgetn(char_type* s, std::streamsize count)
+{
+  std::streamsize done = std::min<std::streamsize>(count, egptr() - gptr());
+  if (done > 0)
+  {
+    std::memcpy(s, gptr(), static_cast<std::size_t>(done));
+    gbump(static_cast<int>(done));
+  }
+  if (done == count)
+  {
+    return done;
+  }
+
+  // read the rest straight into the caller's buffer instead of going through chunks
+  flushWrites();
+  std::size_t pos = position();
+  std::size_t blobSize = _blob.size();
+  std::size_t rest = pos < blobSize ? std::min(static_cast<std::size_t>(count - done), blobSize - pos) : 0;
+  if (rest > 0)
+  {
+    _blob.read(s + done, rest, pos);
+  }
+  _bufferOffset = pos + rest;
+  setg(nullptr, nullptr, nullptr);
+  return done + static_cast<std::streamsize>(rest);
+}
+
+std::streamsize BlobStreamBuf::xsputn(const char_type* s, std::streamsize count)
+{
+  if (static_cast<std::size_t>(count) < _buffer.size() || !_blob.isWritable())
+  {
+    return std::streambuf::xsputn(s, count);
+  }
+
+  // a write of at least a whole chunk gains nothing from buffering
+  std::size_t pos = position();
+  flushWrites();
+  std::size_t blobSize = _blob.size();
+  std::size_t written = pos < blobSize ? std::min(static_cast<std::size_t>(count), blobSize - pos) : 0;
+  if (written > 0)
+  {
+    _blob.write(s, written, pos);
+  }
+  _bufferOffset = pos + written;
+  setg(nullptr, nullptr, nullptr);
+  return static_cast<std::streamsize>(written);
+}
+
+BlobStreamBuf::pos_type BlobStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+  off_type base = 0;
+  if (dir == std::ios_base::cur)
+    base = static_cast<off_type>(position());
+  else if (dir == std::ios_base::end)
+    base = static_cast<off_type>(_blob.size());
+  return seekpos(pos_type(base + off), which);
+}
+
+// reading and writing share one position like in std::filebuf, so which makes no difference
+BlobStreamBuf::pos_type BlobStreamBuf::seekpos(pos_type pos, std::ios_base::openmode)
+{
+  off_type target = static_cast<off_type>(pos);
+  if (target < 0 || static_cast<std::size_t>(target) > _blob.size())
+  {
+    return pos_type(off_type(-1));
+  }
+
+  std::size_t offset = static_cast<std::size_t>(target);
+  // moving within the chunk that is already read needs no I/O
+  if (eback() != nullptr && offset >= _bufferOffset && offset < _bufferOffset + static_cast<std::size_t>(egptr() - eback()))
+  {
+    setg(eback(), eback() + (offset - _bufferOffset), egptr());
+    return pos;
+  }
+
+  flushWrites();
+  _bufferOffset = offset;
+  setg(nullptr, nullptr, nullptr);
+  return pos;
+}
+
+std::streamsize BlobStreamBuf::showmanyc()
+{
+  std::size_t pos = position();
+  std::size_t blobSize = _blob.size();
+  return pos < blobSize ? static_cast<std::streamsize>(blobSize - pos) : -1;
+}
+
+}
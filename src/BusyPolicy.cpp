@@ -0,0 +1,86 @@
+#include "BusyPolicy.h"
+
+#include <algorithm>
+#include <random>
+
+namespace sqlitepp
+{
+
+namespace
+{
+// Same sleep schedule as sqliteDefaultBusyCallback, in milliseconds
+constexpr int SQLITE_BUSY_DELAYS[] = { 1, 2, 5, 10, 15, 20, 25, 25, 25, 50, 50, 100 };
+constexpr std::size_t SQLITE_BUSY_DELAYS_COUNT = sizeof(SQLITE_BUSY_DELAYS) / sizeof(SQLITE_BUSY_DELAYS[0]);
+
+double randomUnit()
+{
+  // each thread gets its own generator so that policies can be shared between connections
+  thread_local std::minstd_rand generator{ std::random_device{}() };
+  return std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+}
+}
+
+std::optional<BusyPolicy::Duration> BusyTimeoutPolicy::onBusy(unsigned int attempt, Duration elapsed)
+{
+  if (elapsed >= _timeout)
+  {
+    return std::nullopt;
+  }
+  std::size_t index = std::min<std::size_t>(attempt, SQLITE_BUSY_DELAYS_COUNT - 1);
+  Duration delay = std::chrono::milliseconds(SQLITE_BUSY_DELAYS[index]);
+  return std::min(delay, _timeout - elapsed);
+}
+
+BackoffBusyPolicy::BackoffBusyPolicy(Duration initialDelay, Duration maxDelay, unsigned int maxRetries, double jitter)
+  : _initialDelay(std::max(initialDelay, Duration(1)))
+  , _maxDelay(std::max(maxDelay, _initialDelay))
+  , _maxRetries(maxRetries)
+  , _jitter(std::clamp(jitter, 0.0, 1.0))
+{}
+
+std::optional<BusyPolicy::Duration> BackoffBusyPolicy::onBusy(unsigned int attempt, Duration /*elapsed*/)
+{
+  if (attempt >= _maxRetries)
+  {
+    return std::nullopt;
+  }
+  return delayFor(attempt);
+}
+
+BusyPolicy::Duration BackoffBusyPolicy::delayFor(unsigned int attempt) const
+{
+  // stop doubling once the cap is reached to avoid overflowing the shift
+  Duration delay = _maxDelay;
+  if (attempt < 32)
+  {
+    auto scaled = _initialDelay.count() << attempt;
+    if (scaled < _maxDelay.count())
+    {
+      delay = Duration(scaled);
+    }
+  }
+
+  if (_jitter > 0.0)
+  {
+    double fixedPart = delay.count() * (1.0 - _jitter);
+    double randomPart = delay.count() * _jitter * randomUnit();
+    delay = Duration(static_cast<Duration::rep>(fixedPart + randomPart));
+  }
+  return std::max(delay, Duration(1));
+}
+
+DeadlineBusyPolicy::DeadlineBusyPolicy(Duration deadline, Duration initialDelay, Duration maxDelay, double jitter)
+  : BackoffBusyPolicy(initialDelay, maxDelay, UNLIMITED_RETRIES, jitter)
+  , _deadline(deadline)
+{}
+
+std::optional<BusyPolicy::Duration> DeadlineBusyPolicy::onBusy(unsigned int attempt, Duration elapsed)
+{
+  if (elapsed >= _deadline)
+  {
+    return std::nullopt;
+  }
+  return std::min(delayFor(attempt), _deadline - elapsed);
+}
+
+}
@@ -0,0 +1,102 @@
+#include "ConnectionPool.h"
+#include "Statement.h"
+#include "exceptions/SQLiteError.h"
+#include "generic/std_format_polyfill.h"
+
+namespace sqlitepp
+{
+
+ConnectionPool::Lease::Lease(Lease&& other)
+  : _pool(other._pool)
+  , _db(other._db)
+  , _writer(other._writer)
+{
+  other._pool = nullptr;
+  other._db = nullptr;
+}
+
+ConnectionPool::Lease::~Lease()
+{
+  if (_pool != nullptr)
+  {
+    _pool->giveBack(_db, _writer);
+  }
+}
+
+ConnectionPool::ConnectionPool(const std::string& path, std::size_t readerCount)
+{
+  if (readerCount == 0)
+  {
+    throw SQLiteError("Connection pool needs at least one reader");
+  }
+
+  // WAL lets the readers run while the writer commits, the setting is persistent in the file.
+  // open throws if a database file refuses it
+  OpenOptions options;
+  options.tuning.journalMode = JournalMode::WAL;
+  _writer = std::make_unique<Database>();
+  _writer->open(path.c_str(), options);
+
+  // in-memory and temporary databases quietly keep their mode, and every connection would get its own
+  std::string journalMode;
+  Statement<std::string> readJournalMode("PRAGMA journal_mode");
+  readJournalMode.Init(_writer.get());
+  readJournalMode.execute([&journalMode](std::string mode) { journalMode = std::move(mode); });
+  if (journalMode != "wal")
+  {
+    throw SQLiteError(std::format("Connection pool needs a database file in WAL mode, '{}' stays in {}", path, journalMode));
+  }
+
+  _readers.reserve(readerCount);
+  _idleReaders.reserve(readerCount);
+  for (std::size_t i = 0; i < readerCount; ++i)
+  {
+    auto reader = std::make_unique<Database>();
+    reader->open(path.c_str(), OpenFlags::READONLY);
+    _idleReaders.push_back(reader.get());
+    _readers.push_back(std::move(reader));
+  }
+}
+
+ConnectionPool::Lease ConnectionPool::acquireReader()
+{
+  std::unique_lock lock(_mutex);
+  _readerReturned.wait(lock, [this]() { return !_idleReaders.empty(); });
+  Database* db = _idleReaders.back();
+  _idleReaders.pop_back();
+  return Lease(*this, db, false);
+}
+
+ConnectionPool::Lease ConnectionPool::acquireWriter()
+{
+  std::unique_lock lock(_mutex);
+  _writerReturned.wait(lock, [this]() { return _writerIdle; });
+  _writerIdle = false;
+  return Lease(*this, _writer.get(), true);
+}
+
+void ConnectionPool::giveBack(Database* db, bool writer)
+{
+  {
+    std::lock_guard lock(_mutex);
+    if (writer)
+    {
+      _writerIdle = true;
+    }
+    else
+    {
+      _idleReaders.push_back(db);
+    }
+  }
+
+  if (writer)
+  {
+    _writerReturned.notify_one();
+  }
+  else
+  {
+    _readerReturned.notify_one();
+  }
+}
+
+}
@@ -2,31 +2,87 @@
 #include "exceptions/SQLiteError.h"
 #include "ResultCode.h"
 #include "private/Database_Private.h"
+#include "private/ArrayModule.h"
+#include "generic/Finally.h"
+#include "generic/std_format_polyfill.h"
+#include "logging/Logger.h"
 
 #include "sqlite3.h"
 
 #include <string>
+#include <thread>
 
 namespace sqlitepp
 {
 
 Database::Database() : _private(new Private)
-{}
+{
+  _private->busyPolicy = std::make_shared<BackoffBusyPolicy>();
+}
 
 void Database::open(const char* path, OpenFlags flags)
 {
-  int result = sqlite3_open_v2(path, &_private->db, static_cast<int>(flags), nullptr);
+  OpenOptions options;
+  options.flags = flags;
+  open(path, options);
+}
+
+void Database::open(const char* path, const OpenOptions& options)
+{
+  options.tuning.validate();
+
+  int result = sqlite3_open_v2(path, &_private->db, static_cast<int>(options.flags), nullptr);
   if (result != SQLITE_OK)
   {
     throw SQLiteError(sqlite3_errmsg(_private->db));
   }
+  sqlite3_busy_handler(_private->db, &Private::busyHandler, _private.get());
+  _private->updateTrace();
+
+  result = registerArrayModule(_private->db);
+  if (result != SQLITE_OK)
+  {
+    throw SQLiteCodedError("Failed to register the array table-valued function", static_cast<ResultCode>(result));
+  }
+
+  try
+  {
+    _private->applyTuning(options.tuning);
+  }
+  catch (...)
+  {
+    // a connection configured only halfway is not handed out
+    sqlite3_close_v2(_private->db);
+    _private->db = nullptr;
+    throw;
+  }
+
+#if SQLITEPP_DEFAULT_WAL
+  // sqlite has no compile option for the default journal mode, the build profile asks for WAL here.
+  // Only a preference: databases that cannot use WAL keep their mode.
+  if (!options.tuning.journalMode && (static_cast<int>(options.flags) & static_cast<int>(OpenFlags::READWRITE)) != 0)
+  {
+    try
+    {
+      _private->pragma("PRAGMA journal_mode=WAL");
+    }
+    catch (const SQLiteError&)
+    {
+    }
+  }
+#endif
 }
 
 void Database::exec(const char* statement, bool wait)
 {
-  int result;
   char* errorMessage = nullptr;
-  while ((result = sqlite3_exec(_private->db, statement, nullptr, nullptr, &errorMessage)) == SQLITE_BUSY && wait);
+  _private->waitOnBusy = wait;
+  Finally restoreWait{ [this]()
+    {
+      _private->waitOnBusy = true;
+    }
+  };
+  int result = sqlite3_exec(_private->db, statement, nullptr, nullptr, &errorMessage);
 
   if (result != SQLITE_OK)
   {
@@ -34,6 +90,8 @@ void Database::exec(const char* statement, bool wait)
     sqlite3_free(errorMessage);
     throw SQLiteCodedError(errorMsg, static_cast<ResultCode>(result));
   }
+  // exec is how schema changes are usually done, checked by keyword so exec runs no extra SQL
+  _private->statementCache->invalidateIfSchemaStatement(statement);
 }
 
 bool Database::isOpen()
@@ -41,8 +99,283 @@ bool Database::isOpen()
   return _private->db != nullptr;
 }
 
+bool Database::isAutocommit() const
+{
+  return sqlite3_get_autocommit(_private->db) != 0;
+}
+
+std::int64_t Database::getLastInsertRowId() const
+{
+  return sqlite3_last_insert_rowid(_private->db);
+}
+
+void Database::setBusyPolicy(std::shared_ptr<BusyPolicy> policy)
+{
+  _private->busyPolicy = std::move(policy);
+}
+
+BusyStats Database::getBusyStats() const
+{
+  BusyStats stats;
+  stats.busyEvents = _private->busyEvents;
+  stats.retries = _private->busyRetries;
+  stats.giveUps = _private->busyGiveUps;
+  stats.waitTime = std::chrono::nanoseconds(_private->busyWaitNs);
+  return stats;
+}
+
+void Database::resetBusyStats()
+{
+  _private->busyEvents = 0;
+  _private->busyRetries = 0;
+  _private->busyGiveUps = 0;
+  _private->busyWaitNs = 0;
+}
+
+void Database::setStatementCacheCapacity(std::size_t capacity)
+{
+  _private->statementCache->setCapacity(capacity);
+}
+
+StatementCacheStats Database::getStatementCacheStats() const
+{
+  return _private->statementCache->getStats();
+}
+
+void Database::clearStatementCache()
+{
+  _private->statementCache->clear();
+}
+
+void Database::setQueryStatsEnabled(bool enabled)
+{
+  _private->queryStatsEnabled = enabled;
+  _private->updateTrace();
+}
+
+bool Database::isQueryStatsEnabled() const
+{
+  return _private->queryStatsEnabled;
+}
+
+std::vector<QueryStats> Database::getQueryStats() const
+{
+  return _private->queryStats.getStats();
+}
+
+void Database::resetQueryStats()
+{
+  _private->queryStats.reset();
+}
+
+void Database::logQueryStats(std::size_t limit) const
+{
+  std::vector<QueryStats> stats = getQueryStats();
+  if (stats.size() > limit)
+  {
+    stats.resize(limit);
+  }
+
+  Logger& logger = getLogger();
+  for (const QueryStats& entry : stats)
+  {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    logger.info("{} runs, {} rows, total {} us, avg {} us, p50 <{} us, p99 <{} us, max {} us, fullscan steps {}, sorts {}, autoindex rows {}, vm steps {}, reprepares {}: {}",
+      entry.executions, entry.rows,
+      duration_cast<microseconds>(entry.totalTime).count(), duration_cast<microseconds>(entry.averageTime()).count(),
+      entry.latencyQuantile(0.5).count(), entry.latencyQuantile(0.99).count(), duration_cast<microseconds>(entry.maxTime).count(),
+      entry.fullscanSteps, entry.sorts, entry.autoindexRows, entry.vmSteps, entry.reprepares, entry.sql);
+  }
+}
+
+void Database::startCheckpointScheduler(const CheckpointOptions& options)
+{
+  _private->checkpointScheduler.reset();
+  _private->checkpointScheduler = std::make_unique<CheckpointScheduler>(_private->db, options);
+}
+
+void Database::stopCheckpointScheduler()
+{
+  _private->checkpointScheduler.reset();
+}
+
+bool Database::isCheckpointSchedulerRunning() const
+{
+  return _private->checkpointScheduler != nullptr;
+}
+
+CheckpointStats Database::getCheckpointStats() const
+{
+  return _private->checkpointScheduler ? _private->checkpointScheduler->getStats() : CheckpointStats{};
+}
+
+void Database::setLogger(Logger* logger)
+{
+  _private->logger = logger != nullptr ? logger : &_private->defaultLogger;
+}
+
+Logger& Database::getLogger() const
+{
+  return *_private->logger;
+}
+
+void Database::Private::execCached(std::string_view sql)
+{
+  sqlite3_stmt* statement = statementCache->acquire(db, sql, PrepareFlags::NONE);
+  int result = sqlite3_step(statement);
+  std::string errorMsg = result == SQLITE_DONE || result == SQLITE_ROW ? "" : sqlite3_errmsg(db);
+  statementCache->release(sql, statement, PrepareFlags::NONE);
+
+  if (!errorMsg.empty())
+  {
+    throw SQLiteCodedError(errorMsg, static_cast<ResultCode>(result));
+  }
+}
+
+std::string Database::Private::pragma(const std::string& sql)
+{
+  sqlite3_stmt* stmt = nullptr;
+  int result = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
+  if (result == SQLITE_OK)
+  {
+    result = sqlite3_step(stmt);
+  }
+
+  std::string value;
+  if (result == SQLITE_ROW)
+  {
+    const unsigned char* text = sqlite3_column_text(stmt, 0);
+    value = text == nullptr ? "" : reinterpret_cast<const char*>(text);
+    result = SQLITE_OK;
+  }
+  else if (result == SQLITE_DONE)
+  {
+    result = SQLITE_OK;
+  }
+  sqlite3_finalize(stmt);
+
+  if (result != SQLITE_OK)
+  {
+    throw SQLiteCodedError(std::format("Failed to apply {}: {}", sql, sqlite3_errmsg(db)), static_cast<ResultCode>(result));
+  }
+  return value;
+}
+
+void Database::Private::applyTuning(const TuningProfile& tuning)
+{
+  // settings of this connection only go first, so that a refused one leaves the file untouched
+  if (tuning.lockingMode)
+  {
+    std::string_view expected = toString(*tuning.lockingMode);
+    std::string mode = pragma(std::format("PRAGMA locking_mode={}", expected));
+    if (mode != expected)
+    {
+      throw SQLiteError(std::format("Cannot set locking mode {}, the database stays in {}", expected, mode));
+    }
+  }
+  if (tuning.synchronous)
+  {
+    pragma(std::format("PRAGMA synchronous={}", static_cast<int>(*tuning.synchronous)));
+  }
+  if (tuning.cacheSize)
+  {
+    pragma(std::format("PRAGMA cache_size={}", *tuning.cacheSize));
+  }
+  if (tuning.mmapSize)
+  {
+    // silently capped at SQLITE_MAX_MMAP_SIZE, and ignored on platforms without mmap
+    pragma(std::format("PRAGMA mmap_size={}", *tuning.mmapSize));
+  }
+  if (tuning.tempStore)
+  {
+    pragma(std::format("PRAGMA temp_store={}", static_cast<int>(*tuning.tempStore)));
+  }
+  if (tuning.walAutocheckpoint)
+  {
+    pragma(std::format("PRAGMA wal_autocheckpoint={}", *tuning.walAutocheckpoint));
+  }
+
+  // page size and journal mode are stored in the file. Page size must be set before WAL is
+  // switched on, after that it can no longer change
+  if (tuning.pageSize)
+  {
+    pragma(std::format("PRAGMA page_size={}", *tuning.pageSize));
+  }
+  if (tuning.journalMode)
+  {
+    std::string_view expected = toString(*tuning.journalMode);
+    std::string mode = pragma(std::format("PRAGMA journal_mode={}", expected));
+    // in-memory and temporary databases have no file of their own, they quietly keep a mode they support
+    const char* filename = sqlite3_db_filename(db, "main");
+    bool hasFile = filename != nullptr && *filename != '\0';
+    if (mode != expected && hasFile)
+    {
+      throw SQLiteError(std::format("Cannot set journal mode {}, the database stays in {}", expected, mode));
+    }
+  }
+}
+
+void Database::Private::updateTrace()
+{
+  if (db == nullptr)
+    return;
+  if (queryStatsEnabled)
+    sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW, &Private::traceCallback, this);
+  else
+    sqlite3_trace_v2(db, 0, nullptr, nullptr);
+}
+
+int Database::Private::traceCallback(unsigned int type, void* self, void* statement, void* detail)
+{
+  Private& p = *static_cast<Private*>(self);
+  auto* stmt = static_cast<sqlite3_stmt*>(statement);
+  if (type == SQLITE_TRACE_ROW)
+  {
+    p.queryStats.recordRow(stmt);
+  }
+  else if (type == SQLITE_TRACE_PROFILE)
+  {
+    p.queryStats.recordExecution(stmt, std::chrono::nanoseconds(*static_cast<sqlite3_int64*>(detail)));
+  }
+  return 0;
+}
+
+int Database::Private::busyHandler(void* self, int attempt)
+{
+  Private& p = *static_cast<Private*>(self);
+  auto now = std::chrono::steady_clock::now();
+  if (attempt == 0)
+  {
+    p.busySince = now;
+    ++p.busyEvents;
+  }
+
+  std::optional<BusyPolicy::Duration> delay;
+  if (p.waitOnBusy && p.busyPolicy)
+  {
+    auto elapsed = std::chrono::duration_cast<BusyPolicy::Duration>(now - p.busySince);
+    delay = p.busyPolicy->onBusy(static_cast<unsigned int>(attempt), elapsed);
+  }
+
+  if (!delay)
+  {
+    ++p.busyGiveUps;
+    // zero makes SQLite return SQLITE_BUSY to the caller
+    return 0;
+  }
+
+  std::this_thread::sleep_for(*delay);
+  p.busyWaitNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - now).count();
+  ++p.busyRetries;
+  return 1;
+}
+
 Database::~Database()
 {
+  _private->checkpointScheduler.reset();
+  _private->statementCache->clear();
+  // statements still alive finalize themselves once the cache is gone, the connection closes with the last one
   sqlite3_close_v2(_private->db);
   _private->db = nullptr;
 }
@@ -0,0 +1,83 @@
+#include "OpenOptions.h"
+#include "exceptions/SQLiteError.h"
+#include "generic/std_format_polyfill.h"
+
+namespace sqlitepp
+{
+
+std::string_view toString(JournalMode mode)
+{
+  switch (mode)
+  {
+  case JournalMode::DELETE_JOURNAL: return "delete";
+  case JournalMode::TRUNCATE: return "truncate";
+  case JournalMode::PERSIST: return "persist";
+  case JournalMode::MEMORY: return "memory";
+  case JournalMode::WAL: return "wal";
+  case JournalMode::OFF: return "off";
+  }
+  return "";
+}
+
+std::string_view toString(LockingMode mode)
+{
+  return mode == LockingMode::EXCLUSIVE ? "exclusive" : "normal";
+}
+
+TuningProfile TuningProfile::bulkLoad()
+{
+  TuningProfile profile;
+  profile.journalMode = JournalMode::MEMORY;
+  profile.synchronous = SynchronousMode::OFF;
+  profile.cacheSize = -256 * 1024;
+  profile.tempStore = TempStore::MEMORY;
+  profile.lockingMode = LockingMode::EXCLUSIVE;
+  return profile;
+}
+
+TuningProfile TuningProfile::readHeavy()
+{
+  TuningProfile profile;
+  profile.journalMode = JournalMode::WAL;
+  profile.synchronous = SynchronousMode::NORMAL;
+  profile.mmapSize = std::int64_t(1024) * 1024 * 1024;
+  profile.cacheSize = -64 * 1024;
+  profile.tempStore = TempStore::MEMORY;
+  return profile;
+}
+
+TuningProfile TuningProfile::durableOltp()
+{
+  TuningProfile profile;
+  profile.journalMode = JournalMode::WAL;
+  profile.synchronous = SynchronousMode::FULL;
+  profile.cacheSize = -16 * 1024;
+  profile.walAutocheckpoint = 1000;
+  return profile;
+}
+
+void TuningProfile::validate() const
+{
+  if (pageSize && (*pageSize < 512 || *pageSize > 65536 || (*pageSize & (*pageSize - 1)) != 0))
+  {
+    throw SQLiteError(std::format("Page size {} is not a power of two between 512 and 65536", *pageSize));
+  }
+  if (mmapSize && *mmapSize < 0)
+  {
+    throw SQLiteError(std::format("Memory map size {} cannot be negative", *mmapSize));
+  }
+  if (synchronous && (*synchronous < SynchronousMode::OFF || *synchronous > SynchronousMode::EXTRA))
+  {
+    throw SQLiteError(std::format("Invalid synchronous mode {}", static_cast<int>(*synchronous)));
+  }
+  if (tempStore && (*tempStore < TempStore::DEFAULT || *tempStore > TempStore::MEMORY))
+  {
+    throw SQLiteError(std::format("Invalid temp store {}", static_cast<int>(*tempStore)));
+  }
+  if (journalMode && toString(*journalMode).empty())
+  {
+    throw SQLiteError(std::format("Invalid journal mode {}", static_cast<int>(*journalMode)));
+  }
+}
+
+}
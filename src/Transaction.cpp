@@ -0,0 +1,116 @@
+#include "Transaction.h"
+#include "private/Database_Private.h"
+#include "logging/Logger.h"
+
+#include <exception>
+#include <string>
+
+namespace sqlitepp
+{
+
+namespace
+{
+const char* beginStatement(TransactionMode mode)
+{
+  switch (mode)
+  {
+    case TransactionMode::IMMEDIATE:
+      return "BEGIN IMMEDIATE";
+    case TransactionMode::EXCLUSIVE:
+      return "BEGIN EXCLUSIVE";
+    case TransactionMode::DEFERRED:
+    default:
+      return "BEGIN DEFERRED";
+  }
+}
+
+// Names depend only on the nesting depth, so that the statements can be reused from the cache
+std::string savepointName(int depth)
+{
+  return "sqlitepp_savepoint_" + std::to_string(depth);
+}
+}
+
+Transaction::Transaction(Database& db, TransactionMode mode)
+  : _db(db)
+{
+  _db._private->execCached(beginStatement(mode));
+  _active = true;
+}
+
+Transaction::~Transaction()
+{
+  if (!_active)
+    return;
+
+  try
+  {
+    rollback();
+  }
+  catch (const std::exception& e)
+  {
+    _db.getLogger().error("Failed to roll back transaction: {}", e.what());
+  }
+}
+
+void Transaction::commit()
+{
+  _db._private->execCached("COMMIT");
+  _active = false;
+}
+
+void Transaction::rollback()
+{
+  _active = false;
+  // some errors make SQLite roll back on its own, ROLLBACK would then fail
+  if (!_db.isAutocommit())
+  {
+    _db._private->execCached("ROLLBACK");
+  }
+}
+
+Savepoint::Savepoint(Database& db)
+  : _db(db)
+  , _depth(db._private->savepointDepth + 1)
+{
+  _db._private->execCached("SAVEPOINT " + savepointName(_depth));
+  _db._private->savepointDepth = _depth;
+  _active = true;
+}
+
+Savepoint::~Savepoint()
+{
+  if (!_active)
+    return;
+
+  try
+  {
+    rollback();
+  }
+  catch (const std::exception& e)
+  {
+    _db.getLogger().error("Failed to roll back savepoint: {}", e.what());
+  }
+}
+
+void Savepoint::release()
+{
+  _db._private->execCached("RELEASE " + savepointName(_depth));
+  _active = false;
+  _db._private->savepointDepth = _depth - 1;
+}
+
+void Savepoint::rollback()
+{
+  _active = false;
+  _db._private->savepointDepth = _depth - 1;
+  if (!_db.isAutocommit())
+  {
+    // ROLLBACK TO keeps the savepoint open, it has to be released as well
+    std::string name = savepointName(_depth);
+    _db._private->execCached("ROLLBACK TO " + name);
+    _db._private->execCached("RELEASE " + name);
+  }
+}
+
+}
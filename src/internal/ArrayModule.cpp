@@ -0,0 +1,189 @@
+#include "../private/ArrayModule.h"
+#include "traits/BindTraits.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "sqlite3.h"
+
+// Eponymous virtual table in the spirit of the carray extension: sqlitepp_array(?) yields one row per
+// element of an array bound with sqlite3_bind_pointer, without copying the elements.
+
+namespace sqlitepp
+{
+
+namespace
+{
+
+constexpr int COLUMN_VALUE = 0;
+constexpr int COLUMN_POINTER = 1;
+
+struct ArrayCursor
+{
+  sqlite3_vtab_cursor base;
+  const ArrayBinding* array;
+  sqlite3_int64 row;
+};
+
+int arrayConnect(sqlite3* db, void*, int, const char* const*, sqlite3_vtab** vtab, char**)
+{
+  int result = sqlite3_declare_vtab(db, "CREATE TABLE x(value, pointer HIDDEN)");
+  if (result != SQLITE_OK)
+  {
+    return result;
+  }
+  *vtab = static_cast<sqlite3_vtab*>(sqlite3_malloc(sizeof(sqlite3_vtab)));
+  if (*vtab == nullptr)
+  {
+    return SQLITE_NOMEM;
+  }
+  **vtab = sqlite3_vtab{};
+  sqlite3_vtab_config(db, SQLITE_VTAB_INNOCUOUS);
+  return SQLITE_OK;
+}
+
+int arrayDisconnect(sqlite3_vtab* vtab)
+{
+  sqlite3_free(vtab);
+  return SQLITE_OK;
+}
+
+int arrayBestIndex(sqlite3_vtab*, sqlite3_index_info* info)
+{
+  for (int i = 0; i < info->nConstraint; ++i)
+  {
+    const auto& constraint = info->aConstraint[i];
+    if (constraint.iColumn == COLUMN_POINTER && constraint.op == SQLITE_INDEX_CONSTRAINT_EQ && constraint.usable)
+    {
+      info->aConstraintUsage[i].argvIndex = 1;
+      info->aConstraintUsage[i].omit = 1;
+      info->idxNum = 1;
+      info->estimatedCost = 1;
+      info->estimatedRows = 100;
+      return SQLITE_OK;
+    }
+  }
+  // without the array argument there is nothing to scan
+  return SQLITE_CONSTRAINT;
+}
+
+int arrayOpen(sqlite3_vtab*, sqlite3_vtab_cursor** cursor)
+{
+  auto* arrayCursor = static_cast<ArrayCursor*>(sqlite3_malloc(sizeof(ArrayCursor)));
+  if (arrayCursor == nullptr)
+  {
+    return SQLITE_NOMEM;
+  }
+  *arrayCursor = ArrayCursor{};
+  *cursor = &arrayCursor->base;
+  return SQLITE_OK;
+}
+
+int arrayClose(sqlite3_vtab_cursor* cursor)
+{
+  sqlite3_free(cursor);
+  return SQLITE_OK;
+}
+
+int arrayFilter(sqlite3_vtab_cursor* cursor, int idxNum, const char*, int argc, sqlite3_value** argv)
+{
+  auto* arrayCursor = reinterpret_cast<ArrayCursor*>(cursor);
+  arrayCursor->row = 0;
+  arrayCursor->array = nullptr;
+  if (idxNum == 1 && argc == 1)
+  {
+    arrayCursor->array = static_cast<const ArrayBinding*>(sqlite3_value_pointer(argv[0], ARRAY_POINTER_TYPE));
+  }
+  return SQLITE_OK;
+}
+
+int arrayNext(sqlite3_vtab_cursor* cursor)
+{
+  ++reinterpret_cast<ArrayCursor*>(cursor)->row;
+  return SQLITE_OK;
+}
+
+int arrayEof(sqlite3_vtab_cursor* cursor)
+{
+  auto* arrayCursor = reinterpret_cast<ArrayCursor*>(cursor);
+  return arrayCursor->array == nullptr || static_cast<std::size_t>(arrayCursor->row) >= arrayCursor->array->size;
+}
+
+int arrayColumn(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int column)
+{
+  auto* arrayCursor = reinterpret_cast<ArrayCursor*>(cursor);
+  if (column != COLUMN_VALUE)
+  {
+    sqlite3_result_null(context);
+    return SQLITE_OK;
+  }
+
+  const ArrayBinding& array = *arrayCursor->array;
+  std::size_t row = static_cast<std::size_t>(arrayCursor->row);
+  // the caller keeps the array alive while the statement runs, so the text does not need to be copied
+  switch (array.type)
+  {
+    case ArrayBinding::Type::INT64:
+      sqlite3_result_int64(context, static_cast<const std::int64_t*>(array.data)[row]);
+      break;
+    case ArrayBinding::Type::DOUBLE:
+      sqlite3_result_double(context, static_cast<const double*>(array.data)[row]);
+      break;
+    case ArrayBinding::Type::STRING:
+    {
+      const std::string& value = static_cast<const std::string*>(array.data)[row];
+      sqlite3_result_text64(context, value.data(), value.size(), SQLITE_STATIC, SQLITE_UTF8);
+      break;
+    }
+    case ArrayBinding::Type::STRING_VIEW:
+    {
+      std::string_view value = static_cast<const std::string_view*>(array.data)[row];
+      sqlite3_result_text64(context, value.data(), value.size(), SQLITE_STATIC, SQLITE_UTF8);
+      break;
+    }
+  }
+  return SQLITE_OK;
+}
+
+int arrayRowid(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid)
+{
+  *rowid = reinterpret_cast<ArrayCursor*>(cursor)->row;
+  return SQLITE_OK;
+}
+
+sqlite3_module arrayModule = {
+  0,                // iVersion
+  nullptr,          // xCreate, eponymous only
+  arrayConnect,
+  arrayBestIndex,
+  arrayDisconnect,
+  nullptr,          // xDestroy
+  arrayOpen,
+  arrayClose,
+  arrayFilter,
+  arrayNext,
+  arrayEof,
+  arrayColumn,
+  arrayRowid,
+  nullptr,          // xUpdate, read only
+  nullptr,          // xBegin
+  nullptr,          // xSync
+  nullptr,          // xCommit
+  nullptr,          // xRollback
+  nullptr,          // xFindFunction
+  nullptr,          // xRename
+  nullptr,          // xSavepoint
+  nullptr,          // xRelease
+  nullptr,          // xRollbackTo
+  nullptr,          // xShadowName
+};
+
+}
+
+int registerArrayModule(sqlite3* db)
+{
+  return sqlite3_create_module(db, ARRAY_FUNCTION, &arrayModule, nullptr);
+}
+
+}
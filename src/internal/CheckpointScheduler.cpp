@@ -0,0 +1,229 @@
+#include "../private/CheckpointScheduler.h"
+#include "exceptions/SQLiteError.h"
+#include "generic/std_format_polyfill.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "sqlite3.h"
+
+namespace sqlitepp
+{
+
+namespace
+{
+std::string pragmaValue(sqlite3* db, const char* sql)
+{
+  sqlite3_stmt* stmt = nullptr;
+  std::string value;
+  if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW)
+  {
+    const unsigned char* text = sqlite3_column_text(stmt, 0);
+    value = text == nullptr ? "" : reinterpret_cast<const char*>(text);
+  }
+  sqlite3_finalize(stmt);
+  return value;
+}
+
+std::int64_t steadyNowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+CheckpointScheduler::CheckpointScheduler(sqlite3* db, const CheckpointOptions& options)
+  : _db(db)
+  , _options(options)
+{
+  const char* filename = sqlite3_db_filename(db, "main");
+  if (filename == nullptr || *filename == '\0')
+  {
+    throw SQLiteError("Checkpoint scheduler needs a database file, not an in-memory or temporary database");
+  }
+  std::string journalMode = pragmaValue(db, "PRAGMA journal_mode");
+  if (journalMode != "wal")
+  {
+    throw SQLiteError(std::format("Checkpoint scheduler needs WAL journal mode, the database is in {}", journalMode));
+  }
+  std::string pageSize = pragmaValue(db, "PRAGMA page_size");
+  if (!pageSize.empty())
+  {
+    _pageSize = std::stoull(pageSize);
+  }
+  _walPath = std::string(filename) + "-wal";
+  // restored when the scheduler stops, it may have been tuned when the database was opened
+  std::string autocheckpoint = pragmaValue(db, "PRAGMA wal_autocheckpoint");
+  if (!autocheckpoint.empty())
+  {
+    _previousAutocheckpoint = std::stoi(autocheckpoint);
+  }
+
+  int result = sqlite3_open_v2(filename, &_checkpointDb, SQLITE_OPEN_READWRITE, nullptr);
+  if (result != SQLITE_OK)
+  {
+    std::string errorMsg = sqlite3_errmsg(_checkpointDb);
+    sqlite3_close_v2(_checkpointDb);
+    throw SQLiteCodedError(std::format("Cannot open checkpoint connection to {}: {}", filename, errorMsg), static_cast<ResultCode>(result));
+  }
+  // the connection only switches to WAL once it reads the file, until then checkpoints do nothing
+  if (pragmaValue(_checkpointDb, "PRAGMA journal_mode") != "wal")
+  {
+    sqlite3_close_v2(_checkpointDb);
+    throw SQLiteError(std::format("Cannot open the WAL of {} for checkpoints", filename));
+  }
+  // only RESTART and TRUNCATE wait, PASSIVE never calls the busy handler
+  sqlite3_busy_timeout(_checkpointDb, static_cast<int>(_options.busyTimeout.count()));
+
+  // a WAL file left from before is checkpointed on the first idle poll
+  _commits = 1;
+  try
+  {
+    _worker = std::thread([this]() { workerLoop(); });
+  }
+  catch (...)
+  {
+    sqlite3_close_v2(_checkpointDb);
+    throw;
+  }
+  // installed last, nothing can fail afterwards and leave the hook pointing to a dead scheduler.
+  // Replaces the automatic checkpoint, which is itself implemented as a WAL hook
+  sqlite3_wal_hook(_db, &CheckpointScheduler::walHook, this);
+}
+
+CheckpointScheduler::~CheckpointScheduler()
+{
+  {
+    std::lock_guard lock(_mutex);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  _worker.join();
+
+  sqlite3_wal_autocheckpoint(_db, _previousAutocheckpoint);
+  sqlite3_close_v2(_checkpointDb);
+}
+
+CheckpointStats CheckpointScheduler::getStats() const
+{
+  std::lock_guard lock(_mutex);
+  CheckpointStats stats = _stats;
+  stats.walFrames = static_cast<std::uint64_t>(_walFrames.load(std::memory_order_relaxed));
+  return stats;
+}
+
+void CheckpointScheduler::workerLoop()
+{
+  std::unique_lock lock(_mutex);
+  while (!_stopping)
+  {
+    _wake.wait_for(lock, _options.pollInterval);
+    if (_stopping)
+      break;
+
+    lock.unlock();
+    poll();
+    lock.lock();
+  }
+}
+
+void CheckpointScheduler::poll()
+{
+  std::uint64_t commits = _commits.load(std::memory_order_acquire);
+  std::error_code ignored;
+  std::uintmax_t fileSize = std::filesystem::file_size(_walPath, ignored);
+  std::uint64_t walFileBytes = fileSize == static_cast<std::uintmax_t>(-1) ? 0 : static_cast<std::uint64_t>(fileSize);
+  {
+    std::lock_guard lock(_mutex);
+    _stats.walBytes = walFileBytes;
+    _stats.maxWalBytes = std::max(_stats.maxWalBytes, walFileBytes);
+  }
+
+  // everything committed so far was copied, only a big leftover file is still worth truncating
+  if (commits == _checkpointedCommits && walFileBytes < _options.truncateBytes)
+    return;
+
+  std::uint64_t walBytes = static_cast<std::uint64_t>(_walFrames.load(std::memory_order_relaxed)) * _pageSize;
+  auto idle = std::chrono::nanoseconds(steadyNowNs() - _lastCommitNs.load(std::memory_order_relaxed));
+
+  CheckpointMode mode;
+  if (walFileBytes >= _options.truncateBytes)
+    mode = CheckpointMode::TRUNCATE;
+  else if (walBytes >= _options.restartBytes)
+    mode = CheckpointMode::RESTART;
+  else if (walBytes >= _options.passiveBytes || idle >= _options.idleTime)
+    mode = CheckpointMode::PASSIVE;
+  else
+    return;
+
+  if (mode != CheckpointMode::PASSIVE && std::chrono::steady_clock::now() < _noEscalationUntil)
+  {
+    // a PASSIVE one is only useful if there is something new to copy
+    if (commits == _checkpointedCommits)
+      return;
+    mode = CheckpointMode::PASSIVE;
+  }
+  checkpoint(mode, commits);
+}
+
+void CheckpointScheduler::checkpoint(CheckpointMode mode, std::uint64_t commits)
+{
+  int logFrames = -1;
+  int checkpointedFrames = -1;
+  auto start = std::chrono::steady_clock::now();
+  int result = sqlite3_wal_checkpoint_v2(_checkpointDb, "main", static_cast<int>(mode), &logFrames, &checkpointedFrames);
+  auto end = std::chrono::steady_clock::now();
+
+  bool complete = result == SQLITE_OK && logFrames >= 0 && logFrames == checkpointedFrames;
+  if (complete)
+  {
+    _checkpointedCommits = commits;
+  }
+  else if (mode != CheckpointMode::PASSIVE)
+  {
+    // the wait blocked writers for nothing, do not do it again right away
+    _noEscalationUntil = end + 10 * _options.busyTimeout;
+  }
+
+  std::lock_guard lock(_mutex);
+  switch (mode)
+  {
+  case CheckpointMode::TRUNCATE: ++_stats.truncateCheckpoints; break;
+  case CheckpointMode::RESTART: ++_stats.restartCheckpoints; break;
+  default: ++_stats.passiveCheckpoints; break;
+  }
+  if (result == SQLITE_BUSY || (result == SQLITE_OK && !complete))
+  {
+    ++_stats.incomplete;
+  }
+  else if (result != SQLITE_OK)
+  {
+    ++_stats.errors;
+    _stats.lastError = static_cast<ResultCode>(result);
+  }
+  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+  _stats.lastDuration = duration;
+  _stats.maxDuration = std::max(_stats.maxDuration, duration);
+  _stats.totalDuration += duration;
+}
+
+int CheckpointScheduler::walHook(void* self, sqlite3*, const char* schema, int frames)
+{
+  if (std::strcmp(schema, "main") != 0)
+    return SQLITE_OK;
+
+  CheckpointScheduler& scheduler = *static_cast<CheckpointScheduler*>(self);
+  int previousFrames = scheduler._walFrames.exchange(frames, std::memory_order_relaxed);
+  scheduler._lastCommitNs.store(steadyNowNs(), std::memory_order_relaxed);
+  scheduler._commits.fetch_add(1, std::memory_order_release);
+  // wake the scheduler only when the threshold is crossed, later commits are picked up by polling
+  std::uint64_t threshold = scheduler._options.passiveBytes;
+  if (static_cast<std::uint64_t>(frames) * scheduler._pageSize >= threshold
+    && static_cast<std::uint64_t>(previousFrames) * scheduler._pageSize < threshold)
+  {
+    scheduler._wake.notify_one();
+  }
+  return SQLITE_OK;
+}
+
+}
@@ -0,0 +1,242 @@
+#include "../private/QueryStatsRegistry.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+#include "sqlite3.h"
+
+namespace sqlitepp
+{
+
+std::chrono::microseconds QueryStats::latencyQuantile(double quantile) const
+{
+  std::uint64_t total = 0;
+  for (std::uint64_t count : latencyHistogram)
+    total += count;
+  if (total == 0)
+    return {};
+
+  auto target = static_cast<std::uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < LATENCY_BUCKETS; ++i)
+  {
+    seen += latencyHistogram[i];
+    if (seen > target || seen == total)
+      return std::chrono::microseconds(std::uint64_t(1) << i);
+  }
+  return std::chrono::microseconds(std::uint64_t(1) << (LATENCY_BUCKETS - 1));
+}
+
+namespace
+{
+bool isIdentifierChar(char c)
+{
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+std::size_t latencyBucket(std::chrono::nanoseconds elapsed)
+{
+  auto micros = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+  // bit_width(0) is 0, so executions under 1us land in the first bucket
+  return std::min<std::size_t>(std::bit_width(micros), QueryStats::LATENCY_BUCKETS - 1);
+}
+}
+
+std::string QueryStatsRegistry::normalize(std::string_view sql)
+{
+  std::string result;
+  result.reserve(sql.size());
+  bool pendingSpace = false;
+
+  auto append = [&](std::string_view token)
+  {
+    if (pendingSpace && !result.empty())
+      result += ' ';
+    pendingSpace = false;
+    result.append(token);
+  };
+
+  std::size_t pos = 0;
+  while (pos < sql.size())
+  {
+    char c = sql[pos];
+    char next = pos + 1 < sql.size() ? sql[pos + 1] : '\0';
+    if (std::isspace(static_cast<unsigned char>(c)))
+    {
+      pendingSpace = true;
+      ++pos;
+    }
+    else if (c == '-' && next == '-')
+    {
+      std::size_t end = sql.find('\n', pos);
+      pos = end == std::string_view::npos ? sql.size() : end;
+      pendingSpace = true;
+    }
+    else if (c == '/' && next == '*')
+    {
+      std::size_t end = sql.find("*/", pos + 2);
+      pos = end == std::string_view::npos ? sql.size() : end + 2;
+      pendingSpace = true;
+    }
+    else if (c == '\'')
+    {
+      // string literal, '' is an escaped quote inside it
+      ++pos;
+      while (pos < sql.size())
+      {
+        if (sql[pos] == '\'' && (pos + 1 >= sql.size() || sql[pos + 1] != '\''))
+          break;
+        pos += sql[pos] == '\'' ? 2 : 1;
+      }
+      ++pos;
+      append("?");
+    }
+    else if (c == '"' || c == '`' || c == '[')
+    {
+      // quoted identifiers are kept as they are
+      char close = c == '[' ? ']' : c;
+      std::size_t end = sql.find(close, pos + 1);
+      end = end == std::string_view::npos ? sql.size() : end + 1;
+      append(sql.substr(pos, end - pos));
+      pos = end;
+    }
+    else if (std::isdigit(static_cast<unsigned char>(c)) || (c == '.' && std::isdigit(static_cast<unsigned char>(next))))
+    {
+      // numeric literal, including hex, decimals and exponents
+      while (pos < sql.size() && (isIdentifierChar(sql[pos]) || sql[pos] == '.'
+        || ((sql[pos] == '+' || sql[pos] == '-') && (sql[pos - 1] == 'e' || sql[pos - 1] == 'E'))))
+      {
+        ++pos;
+      }
+      append("?");
+    }
+    else if (isIdentifierChar(c))
+    {
+      std::size_t end = pos;
+      while (end < sql.size() && isIdentifierChar(sql[end]))
+        ++end;
+      append(sql.substr(pos, end - pos));
+      pos = end;
+    }
+    else if (c == '?')
+    {
+      // ?NNN becomes plain ?
+      ++pos;
+      while (pos < sql.size() && std::isdigit(static_cast<unsigned char>(sql[pos])))
+        ++pos;
+      append("?");
+    }
+    else if (c == ';' && sql.find_first_not_of(" \t\r\n;", pos) == std::string_view::npos)
+    {
+      // a trailing semicolon does not make a different query
+      break;
+    }
+    else
+    {
+      append(sql.substr(pos, 1));
+      ++pos;
+    }
+  }
+  return result;
+}
+
+void QueryStatsRegistry::recordRow(sqlite3_stmt* statement)
+{
+  // statements SQLite runs internally, like reading the schema, report rows but never finish
+  if (sqlite3_sql(statement) == nullptr)
+    return;
+
+  // uncontended unless reset runs on another thread, which also clears the pending rows
+  std::lock_guard lock(_mutex);
+  for (auto& pending : _pendingRows)
+  {
+    if (pending.first == statement)
+    {
+      ++pending.second;
+      return;
+    }
+  }
+  _pendingRows.emplace_back(statement, 1);
+}
+
+void QueryStatsRegistry::recordExecution(sqlite3_stmt* statement, std::chrono::nanoseconds elapsed)
+{
+  // read and reset, so that every execution adds only its own work
+  auto status = [statement](int op) { return static_cast<std::uint64_t>(sqlite3_stmt_status(statement, op, 1)); };
+  std::uint64_t fullscanSteps = status(SQLITE_STMTSTATUS_FULLSCAN_STEP);
+  std::uint64_t sorts = status(SQLITE_STMTSTATUS_SORT);
+  std::uint64_t autoindexRows = status(SQLITE_STMTSTATUS_AUTOINDEX);
+  std::uint64_t vmSteps = status(SQLITE_STMTSTATUS_VM_STEP);
+  std::uint64_t reprepares = status(SQLITE_STMTSTATUS_REPREPARE);
+
+  const char* rawSql = sqlite3_sql(statement);
+  std::string_view sql = rawSql != nullptr ? rawSql : "";
+
+  std::lock_guard lock(_mutex);
+  std::uint64_t rows = 0;
+  auto pending = std::find_if(_pendingRows.begin(), _pendingRows.end(), [statement](const auto& entry) { return entry.first == statement; });
+  if (pending != _pendingRows.end())
+  {
+    rows = pending->second;
+    *pending = _pendingRows.back();
+    _pendingRows.pop_back();
+  }
+
+  std::string normalizedSql;
+  auto normalized = _normalized.find(sql);
+  if (normalized != _normalized.end())
+  {
+    normalizedSql = normalized->second;
+  }
+  else
+  {
+    normalizedSql = normalize(sql);
+    // SQL with inline literals produces a new text on every execution, those are not worth keeping
+    if (_normalized.size() < MAX_NORMALIZED_TEXTS)
+    {
+      _normalized.emplace(std::string(sql), normalizedSql);
+    }
+  }
+
+  QueryStats& stats = _entries[normalizedSql];
+  if (stats.executions == 0)
+  {
+    stats.sql = std::move(normalizedSql);
+  }
+  ++stats.executions;
+  stats.rows += rows;
+  stats.totalTime += elapsed;
+  stats.maxTime = std::max(stats.maxTime, elapsed);
+  ++stats.latencyHistogram[latencyBucket(elapsed)];
+  stats.fullscanSteps += fullscanSteps;
+  stats.sorts += sorts;
+  stats.autoindexRows += autoindexRows;
+  stats.vmSteps += vmSteps;
+  stats.reprepares += reprepares;
+}
+
+std::vector<QueryStats> QueryStatsRegistry::getStats() const
+{
+  std::vector<QueryStats> result;
+  {
+    std::lock_guard lock(_mutex);
+    result.reserve(_entries.size());
+    for (const auto& entry : _entries)
+    {
+      result.push_back(entry.second);
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const QueryStats& a, const QueryStats& b) { return a.totalTime > b.totalTime; });
+  return result;
+}
+
+void QueryStatsRegistry::reset()
+{
+  std::lock_guard lock(_mutex);
+  _entries.clear();
+  _normalized.clear();
+  _pendingRows.clear();
+}
+
+}
@@ -1,19 +1,31 @@
 #include "internal/RawStatement.h"
 #include "../private/Database_Private.h"
+#include "../private/ArrayModule.h"
 #include "exceptions/SQLiteError.h"
 #include "generic/Finally.h"
+#include "logging/Logger.h"
 
 #include <limits>
-#include <iostream>
+#include <memory>
 
 #include "sqlite3.h"
 
 namespace sqlitepp
 {
 
+namespace
+{
+sqlite3_destructor_type destructorFor(BindLifetime lifetime)
+{
+  return lifetime == BindLifetime::TRANSIENT ? SQLITE_TRANSIENT : SQLITE_STATIC;
+}
+}
+
 struct RawStatement::Private
 {
   sqlite3_stmt* statement = nullptr;
+  // expires with the database, the statement is then finalized instead of given back
+  std::weak_ptr<StatementCache> cache;
 };
 
 RawStatement::RawStatement(const std::string& query,PrepareFlags flags)
@@ -26,68 +38,81 @@ RawStatement::RawStatement(const std::string& query,PrepareFlags flags)
 
 void RawStatement::Execute(const RowCallback& rowHandler)
 {
-  _binder.Reset();
-  _executing = true;
-  Finally f{ [this]()
-    {
-      _executing = false;
-    }
-  };
+  Execute<const RowCallback&>(rowHandler);
+}
 
-  bool done = true;
-  do
+bool RawStatement::Step()
+{
+  auto result = sqlite3_step(_private->statement);
+  switch (result)
   {
-    auto result = sqlite3_step(_private->statement);
-    done = true;
-    switch (result)
+    case SQLITE_ROW:
     {
-      case SQLITE_ROW: 
-      {
-        ReadHelper helper(*this);
-        done = !rowHandler(helper);
-        break;
-      }
-      case SQLITE_BUSY: 
-      {
-        done = false;
-        break; 
-      }
-      case SQLITE_DONE:
-      {
-        break;
-      }
-      default:
-      {
-        std::cout << sqlite3_errmsg(_db->_private->db) << "\n";
-        throw SQLiteCodedError("Failed to perform step on a prepared statement", (ResultCode)result);
-      }
+      return true;
     }
-
-  } while (!done);
+    case SQLITE_DONE:
+    {
+      return false;
+    }
+    case SQLITE_BUSY:
+    {
+      // waiting already happened in the busy handler, so the busy policy has given up
+      throw SQLiteCodedError("Database is locked, busy policy gave up waiting", ResultCode::BUSY);
+    }
+    default:
+    {
+      logger().error("Step failed with code {}: {}", result, sqlite3_errmsg(_db->_private->db));
+      throw SQLiteCodedError("Failed to perform step on a prepared statement", (ResultCode)result);
+    }
+  }
 }
 
 void RawStatement::Init()
 {
   if (!_initCalled)
   {
+    _private->statement = _db->_private->statementCache->acquire(_db->_private->db, _query, _flags);
+    _private->cache = _db->_private->statementCache;
     _initCalled = true;
-    const char* tail = nullptr;
-    if (_query.length() >= (std::size_t)std::numeric_limits<int>::max())
-    {
-      throw SQLiteError(std::format("Cannot prepare query of size {}, it exceeds int size", _query.length()));
-    }
-    int result = sqlite3_prepare_v3(_db->_private->db, _query.data(), (int)_query.length(), static_cast<unsigned int>(_flags), &_private->statement, &tail);
 
-    if (result != SQLITE_OK)
+    // remember the bind parameter count for sanity checks
+    _bindCount = sqlite3_bind_parameter_count(_private->statement);
+
+    // column metadata does not change for a prepared statement, so read it only once
+    _columnCount = sqlite3_column_count(_private->statement);
+    _columns.clear();
+    _columns.reserve(_columnCount);
+    for (int i = 0; i < _columnCount; ++i)
     {
-      throw SQLiteCodedError("Error preparing statement.", static_cast<ResultCode>(result));
+      const char* name = sqlite3_column_name(_private->statement, i);
+      const char* declaredType = sqlite3_column_decltype(_private->statement, i);
+      _columns.push_back({ name != nullptr ? name : "", declaredType != nullptr ? declaredType : "" });
     }
 
-    // remember the bind parameter count for sanity checks
-    _bindCount = sqlite3_bind_parameter_count(_private->statement);
+    _isValid = _expectedColumnCount < 0 || _expectedColumnCount == _columnCount;
+  }
+
+  if (!_isValid)
+  {
+    throw SQLiteError(std::format("Statement reads {} columns but the query returns {}", _expectedColumnCount, _columnCount));
   }
 }
 
+void RawStatement::Reset()
+{
+  if (_private->statement != nullptr)
+  {
+    sqlite3_reset(_private->statement);
+    sqlite3_clear_bindings(_private->statement);
+  }
+  _binder.Reset();
+}
+
+Logger& RawStatement::logger() const
+{
+  return *_db->_private->logger;
+}
+
 void RawStatement::SetDb(Database* db)
 {
   if (_db != nullptr && db != _db)
@@ -120,57 +145,117 @@ void RawStatement::BindHelper::Bind(double doubleVal)
   int result = sqlite3_bind_double(_stmt._private->statement, ++index, doubleVal);
   if (result != SQLITE_OK)
   {
-    std::cout << sqlite3_errmsg(_stmt._db->_private->db) << "\n";
+    _stmt.logger().error("Failed to bind parameter #{}: {}", index, sqlite3_errmsg(_stmt._db->_private->db));
     throw SQLiteCodedError("Failed to bind", (ResultCode)result);
   }
 }
 
-void RawStatement::BindHelper::Bind(const char* strval)
+void RawStatement::BindHelper::Bind(const char* strval, BindLifetime lifetime)
 {
   bindSanityCheck();
-  int result = sqlite3_bind_text(_stmt._private->statement, ++index, strval, -1, SQLITE_STATIC);
+  int result = sqlite3_bind_text(_stmt._private->statement, ++index, strval, -1, destructorFor(lifetime));
 
   if (result != SQLITE_OK)
   {
-    std::cout << sqlite3_errmsg(_stmt._db->_private->db) << "\n";
+    _stmt.logger().error("Failed to bind parameter #{}: {}", index, sqlite3_errmsg(_stmt._db->_private->db));
     throw SQLiteCodedError("Failed to bind", (ResultCode)result);
   }
 }
 
-void RawStatement::BindHelper::Bind(const char* strval, std::size_t strLen)
+void RawStatement::BindHelper::Bind(const char* strval, std::size_t strLen, BindLifetime lifetime)
 {
   bindSanityCheck();
   int result = SQLITE_ERROR;
 
   if (strLen >= static_cast<std::size_t>(std::numeric_limits<int>::max()))
   {
-    result = sqlite3_bind_text64(_stmt._private->statement, ++index, strval, static_cast<sqlite_uint64>(strLen), SQLITE_STATIC, SQLITE_UTF8);
+    result = sqlite3_bind_text64(_stmt._private->statement, ++index, strval, static_cast<sqlite_uint64>(strLen), destructorFor(lifetime), SQLITE_UTF8);
   }
   else
   {
-    result = sqlite3_bind_text(_stmt._private->statement, ++index, strval, static_cast<int>(strLen), SQLITE_STATIC);
+    result = sqlite3_bind_text(_stmt._private->statement, ++index, strval, static_cast<int>(strLen), destructorFor(lifetime));
   }
 
   if (result != SQLITE_OK)
   {
-    std::cout << sqlite3_errmsg(_stmt._db->_private->db) << "\n";
+    _stmt.logger().error("Failed to bind parameter #{}: {}", index, sqlite3_errmsg(_stmt._db->_private->db));
     throw SQLiteCodedError("Failed to bind", (ResultCode)result);
   }
 }
 
-void RawStatement::BindHelper::Bind(const void* blobData, std::size_t dataLen)
+void RawStatement::BindHelper::Bind(const void* blobData, std::size_t dataLen, BindLifetime lifetime)
 {
   bindSanityCheck();
   if (dataLen >= static_cast<std::size_t>(std::numeric_limits<int>::max()))
   {
-    sqlite3_bind_blob64(_stmt._private->statement, ++index, blobData, static_cast<sqlite_uint64>(dataLen), SQLITE_STATIC);
+    sqlite3_bind_blob64(_stmt._private->statement, ++index, blobData, static_cast<sqlite_uint64>(dataLen), destructorFor(lifetime));
   }
   else
   {
-    sqlite3_bind_blob(_stmt._private->statement, ++index, blobData, static_cast<int>(dataLen), SQLITE_STATIC);
+    sqlite3_bind_blob(_stmt._private->statement, ++index, blobData, static_cast<int>(dataLen), destructorFor(lifetime));
+  }
+}
+
+void RawStatement::BindHelper::BindZeroBlob(std::uint64_t size)
+{
+  bindSanityCheck();
+  int result = sqlite3_bind_zeroblob64(_stmt._private->statement, ++index, static_cast<sqlite3_uint64>(size));
+  if (result != SQLITE_OK)
+  {
+    _stmt.logger().error("Failed to bind parameter #{}: {}", index, sqlite3_errmsg(_stmt._db->_private->db));
+    throw SQLiteCodedError("Failed to bind", (ResultCode)result);
+  }
+}
+
+void RawStatement::BindHelper::BindNull()
+{
+  bindSanityCheck();
+  int result = sqlite3_bind_null(_stmt._private->statement, ++index);
+  if (result != SQLITE_OK)
+  {
+    _stmt.logger().error("Failed to bind parameter #{}: {}", index, sqlite3_errmsg(_stmt._db->_private->db));
+    throw SQLiteCodedError("Failed to bind", (ResultCode)result);
+  }
+}
+
+template <typename TValue>
+void RawStatement::BindHelper::bindArray(const TValue* values, std::size_t count, int type)
+{
+  bindSanityCheck();
+  // SQLite owns the small descriptor and deletes it when the binding is cleared
+  auto* binding = new ArrayBinding{ values, count, static_cast<ArrayBinding::Type>(type) };
+  int result = sqlite3_bind_pointer(_stmt._private->statement, ++index, binding, ARRAY_POINTER_TYPE, [](void* ptr)
+  {
+    delete static_cast<ArrayBinding*>(ptr);
+  });
+
+  if (result != SQLITE_OK)
+  {
+    _stmt.logger().error("Failed to bind parameter #{}: {}", index, sqlite3_errmsg(_stmt._db->_private->db));
+    throw SQLiteCodedError("Failed to bind", (ResultCode)result);
   }
 }
 
+void RawStatement::BindHelper::BindArray(const std::int64_t* values, std::size_t count)
+{
+  bindArray(values, count, static_cast<int>(ArrayBinding::Type::INT64));
+}
+
+void RawStatement::BindHelper::BindArray(const double* values, std::size_t count)
+{
+  bindArray(values, count, static_cast<int>(ArrayBinding::Type::DOUBLE));
+}
+
+void RawStatement::BindHelper::BindArray(const std::string* values, std::size_t count)
+{
+  bindArray(values, count, static_cast<int>(ArrayBinding::Type::STRING));
+}
+
+void RawStatement::BindHelper::BindArray(const std::string_view* values, std::size_t count)
+{
+  bindArray(values, count, static_cast<int>(ArrayBinding::Type::STRING_VIEW));
+}
+
 RawStatement::BindHelper::~BindHelper()
 {
   //if (index > 0)
@@ -184,7 +269,7 @@ int RawStatement::ReadHelper::ReadInt()
   readSanityCheck();
   int current = index;
   auto result = sqlite3_column_int(_stmt._private->statement, index++);
-  std::cout << std::format("Read int from column {} -> {}\n", current, result);
+  _stmt.logger().trace("Read int from column {} -> {}", current, result);
   return result;
 }
 
@@ -199,40 +284,53 @@ double RawStatement::ReadHelper::ReadDouble()
   readSanityCheck();
   int current = index;
   auto result = sqlite3_column_double(_stmt._private->statement, index++);
-  std::cout << std::format("Read double from column {} -> {}\n", current, result);
+  _stmt.logger().trace("Read double from column {} -> {}", current, result);
   return result;
 }
 
 StrUnowned RawStatement::ReadHelper::ReadString()
 {
   readSanityCheck();
-  ++index;
-  return { 
-    (StrUnowned::byte_t*)sqlite3_column_text(_stmt._private->statement, index - 1),
-    (std::size_t)sqlite3_column_bytes(_stmt._private->statement, index - 1)
-  };
+  int column = index++;
+  // sqlite3_column_bytes must come after the data accessor, otherwise the length may describe a different encoding
+  auto data = sqlite3_column_text(_stmt._private->statement, column);
+  auto length = sqlite3_column_bytes(_stmt._private->statement, column);
+  return { (StrUnowned::byte_t*)data, (std::size_t)length };
 }
 
 BytesUnowned RawStatement::ReadHelper::ReadBlob()
 {
   readSanityCheck();
-  ++index;
-  return {
-    (BytesUnowned::byte_t*)sqlite3_column_text(_stmt._private->statement, index - 1),
-    (std::size_t)sqlite3_column_bytes(_stmt._private->statement, index - 1)
-  };
+  int column = index++;
+  auto data = sqlite3_column_blob(_stmt._private->statement, column);
+  auto length = sqlite3_column_bytes(_stmt._private->statement, column);
+  return { (BytesUnowned::byte_t*)data, (std::size_t)length };
 }
 
-void RawStatement::ReadHelper::readSanityCheck() const
+bool RawStatement::ReadHelper::IsNull() const
 {
-  int count = sqlite3_column_count(_stmt._private->statement);
-  if (count <= index)
-    throw SQLiteError(std::format("Cannot read column #{}, only {} columns available", index, count));
+  readSanityCheck();
+  return sqlite3_column_type(_stmt._private->statement, index) == SQLITE_NULL;
 }
 
-RawStatement::~RawStatement()
+void RawStatement::ReadHelper::Skip()
 {
+  readSanityCheck();
+  ++index;
+}
 
+RawStatement::~RawStatement()
+{
+  if (_private->statement != nullptr)
+  {
+    // hand the prepared statement back so that the next Statement with the same query skips prepare.
+    // If the database was destroyed first, finalizing lets its deferred sqlite3_close_v2 complete.
+    if (std::shared_ptr<StatementCache> cache = _private->cache.lock())
+      cache->release(_query, _private->statement, _flags);
+    else
+      sqlite3_finalize(_private->statement);
+    _private->statement = nullptr;
+  }
 }
 
 }
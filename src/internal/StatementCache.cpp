@@ -0,0 +1,166 @@
+#include "../private/StatementCache.h"
+#include "exceptions/SQLiteError.h"
+#include "generic/std_format_polyfill.h"
+
+#include <cctype>
+#include <limits>
+
+#include "sqlite3.h"
+
+namespace sqlitepp
+{
+
+namespace
+{
+// Only checks the leading keyword, good enough to notice CREATE/DROP/ALTER sent through a Statement
+bool isSchemaStatement(const char* sql)
+{
+  if (sql == nullptr)
+    return false;
+  while (std::isspace(static_cast<unsigned char>(*sql)))
+    ++sql;
+  for (const char* keyword : { "CREATE", "DROP", "ALTER" })
+  {
+    if (sqlite3_strnicmp(sql, keyword, static_cast<int>(std::char_traits<char>::length(keyword))) == 0)
+      return true;
+  }
+  return false;
+}
+}
+
+StatementCache::~StatementCache()
+{
+  clear();
+}
+
+sqlite3_stmt* StatementCache::acquire(sqlite3* db, std::string_view sql, PrepareFlags flags)
+{
+  {
+    std::lock_guard lock(_mutex);
+    auto range = _index.equal_range(sql);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second->flags == flags)
+      {
+        sqlite3_stmt* statement = it->second->statement;
+        _lru.erase(it->second);
+        _index.erase(it);
+        ++_stats.hits;
+        return statement;
+      }
+    }
+    ++_stats.misses;
+  }
+
+  if (sql.length() >= (std::size_t)std::numeric_limits<int>::max())
+  {
+    throw SQLiteError(std::format("Cannot prepare query of size {}, it exceeds int size", sql.length()));
+  }
+
+  // statements that may be cached will live long, let sqlite know
+  unsigned int prepareFlags = static_cast<unsigned int>(flags);
+  if (_capacity > 0)
+  {
+    prepareFlags |= static_cast<unsigned int>(PrepareFlags::PERSISTENT);
+  }
+
+  sqlite3_stmt* statement = nullptr;
+  const char* tail = nullptr;
+  int result = sqlite3_prepare_v3(db, sql.data(), (int)sql.length(), prepareFlags, &statement, &tail);
+  if (result != SQLITE_OK)
+  {
+    sqlite3_finalize(statement);
+    throw SQLiteCodedError(std::string("Error preparing statement: ") + sqlite3_errmsg(db), static_cast<ResultCode>(result));
+  }
+  return statement;
+}
+
+void StatementCache::release(std::string_view sql, sqlite3_stmt* stmt, PrepareFlags flags)
+{
+  if (stmt == nullptr)
+    return;
+
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  std::lock_guard lock(_mutex);
+  if (isSchemaStatement(sqlite3_sql(stmt)))
+  {
+    // cached plans for the old schema would only be re-prepared on next use, drop them now
+    clearLocked();
+    ++_stats.invalidations;
+  }
+
+  if (_capacity == 0)
+  {
+    sqlite3_finalize(stmt);
+    return;
+  }
+
+  evictLocked(_capacity - 1);
+  _lru.push_front(Entry{ std::string(sql), flags, stmt });
+  _index.emplace(std::string_view(_lru.front().sql), _lru.begin());
+}
+
+void StatementCache::clear()
+{
+  std::lock_guard lock(_mutex);
+  clearLocked();
+}
+
+void StatementCache::invalidateIfSchemaStatement(const char* sql)
+{
+  if (!isSchemaStatement(sql))
+    return;
+  std::lock_guard lock(_mutex);
+  clearLocked();
+  ++_stats.invalidations;
+}
+
+void StatementCache::setCapacity(std::size_t capacity)
+{
+  std::lock_guard lock(_mutex);
+  _capacity = capacity;
+  evictLocked(_capacity);
+}
+
+StatementCacheStats StatementCache::getStats() const
+{
+  std::lock_guard lock(_mutex);
+  StatementCacheStats stats = _stats;
+  stats.size = _lru.size();
+  stats.capacity = _capacity;
+  return stats;
+}
+
+void StatementCache::clearLocked()
+{
+  for (Entry& entry : _lru)
+  {
+    sqlite3_finalize(entry.statement);
+  }
+  _index.clear();
+  _lru.clear();
+}
+
+void StatementCache::evictLocked(std::size_t targetSize)
+{
+  while (_lru.size() > targetSize)
+  {
+    Entry& oldest = _lru.back();
+    auto range = _index.equal_range(std::string_view(oldest.sql));
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second->statement == oldest.statement)
+      {
+        _index.erase(it);
+        break;
+      }
+    }
+    sqlite3_finalize(oldest.statement);
+    _lru.pop_back();
+    ++_stats.evictions;
+  }
+}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+
+struct sqlite3;
+
+namespace sqlitepp
+{
+
+//! What a bound array parameter points to, owned by SQLite through sqlite3_bind_pointer.
+//! The elements themselves belong to the caller and are not copied.
+struct ArrayBinding
+{
+  enum class Type
+  {
+    INT64,
+    DOUBLE,
+    STRING,
+    STRING_VIEW,
+  };
+
+  const void* data;
+  std::size_t size;
+  Type type;
+};
+
+//! Pointer type tag passed to sqlite3_bind_pointer/sqlite3_value_pointer
+constexpr const char* ARRAY_POINTER_TYPE = "sqlitepp_array";
+
+//! Registers the array table-valued function on the connection
+int registerArrayModule(sqlite3* db);
+
+}
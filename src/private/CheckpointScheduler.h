@@ -0,0 +1,68 @@
+#pragma once
+#include "Checkpoint.h"
+#include "generic/NoCopy.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct sqlite3;
+
+namespace sqlitepp
+{
+
+//! Takes WAL checkpoints of one connection's database off the committing threads.
+//! Replaces the connection's automatic checkpoint with a WAL hook that only records the WAL size,
+//! and checkpoints from a second connection on a background thread, since the first one may be
+//! busy or not safe to use from another thread. Commits made by other connections are not seen
+//! by the hook, they still checkpoint according to their own settings.
+class CheckpointScheduler : public NoCopy
+{
+public:
+  //! Starts the thread, throws SQLiteError if the database is not a file in WAL mode
+  CheckpointScheduler(sqlite3* db, const CheckpointOptions& options);
+  //! Stops the thread and restores the automatic checkpoint the connection had before.
+  //! Must be called on the thread that owns db, with no statement running.
+  ~CheckpointScheduler();
+
+  CheckpointStats getStats() const;
+
+private:
+  sqlite3* _db;
+  sqlite3* _checkpointDb = nullptr;
+  CheckpointOptions _options;
+  std::string _walPath;
+  std::uint64_t _pageSize = 4096;
+  // SQLITE_DEFAULT_WAL_AUTOCHECKPOINT unless the connection was configured otherwise
+  int _previousAutocheckpoint = 1000;
+
+  // written by the WAL hook on the committing thread
+  std::atomic<int> _walFrames = 0;
+  std::atomic<std::uint64_t> _commits = 0;
+  std::atomic<std::int64_t> _lastCommitNs = 0;
+
+  // worker thread only: commit count when the last checkpoint copied everything, nothing to do
+  // until it changes, and the time before which RESTART and TRUNCATE are not tried again
+  std::uint64_t _checkpointedCommits = 0;
+  std::chrono::steady_clock::time_point _noEscalationUntil;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _wake;
+  bool _stopping = false;
+  CheckpointStats _stats;
+  std::thread _worker;
+
+  void workerLoop();
+  //! Checks the WAL and runs a checkpoint if one is due
+  void poll();
+  void checkpoint(CheckpointMode mode, std::uint64_t commits);
+
+  // Installed with sqlite3_wal_hook
+  static int walHook(void* self, sqlite3*, const char* schema, int frames);
+};
+
+}
@@ -1,5 +1,17 @@
 #pragma once
 #include "Database.h"
+#include "BusyPolicy.h"
+#include "StatementCache.h"
+#include "CheckpointScheduler.h"
+#include "QueryStatsRegistry.h"
+#include "logging/DummyLogger.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
 
 struct sqlite3;
 
@@ -9,6 +21,47 @@ namespace sqlitepp
 struct Database::Private
 {
   sqlite3* db = nullptr;
+
+  // shared so that statements outliving the database can tell it is gone and finalize directly
+  std::shared_ptr<StatementCache> statementCache = std::make_shared<StatementCache>();
+
+  // number of open Savepoint guards, used to name them
+  int savepointDepth = 0;
+
+  QueryStatsRegistry queryStats;
+  bool queryStatsEnabled = false;
+
+  std::unique_ptr<CheckpointScheduler> checkpointScheduler;
+
+  DummyLogger defaultLogger;
+  Logger* logger = &defaultLogger;
+
+  std::shared_ptr<BusyPolicy> busyPolicy;
+  // when false, the busy handler gives up immediately regardless of the policy
+  bool waitOnBusy = true;
+  // when the currently contended lock was first found busy
+  std::chrono::steady_clock::time_point busySince;
+
+  std::atomic<std::uint64_t> busyEvents = 0;
+  std::atomic<std::uint64_t> busyRetries = 0;
+  std::atomic<std::uint64_t> busyGiveUps = 0;
+  std::atomic<std::int64_t> busyWaitNs = 0;
+
+  //! Runs a statement that returns no rows using the statement cache, for short control statements like BEGIN
+  void execCached(std::string_view sql);
+
+  //! Runs a PRAGMA and returns the first column of its first row, empty if it returns nothing
+  std::string pragma(const std::string& sql);
+  //! Applies the set settings in an order sqlite accepts, throws if one is refused
+  void applyTuning(const TuningProfile& tuning);
+
+  //! Installs or removes the trace callback according to queryStatsEnabled
+  void updateTrace();
+
+  // Installed with sqlite3_busy_handler, forwards to the busy policy
+  static int busyHandler(void* self, int attempt);
+  // Installed with sqlite3_trace_v2, feeds the query statistics
+  static int traceCallback(unsigned int type, void* self, void* statement, void* detail);
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "QueryStats.h"
+#include "generic/NoCopy.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct sqlite3_stmt;
+
+namespace sqlitepp
+{
+
+//! Collects QueryStats from the sqlite3_trace_v2 callbacks of one connection.
+//! Recording happens on the thread using the connection and relies on the connection being used
+//! from one thread at a time, as SQLITE_THREADSAFE=2 builds do not serialize the callbacks.
+//! Reading and resetting may happen on any thread.
+class QueryStatsRegistry : public NoCopy
+{
+public:
+  //! Number of raw SQL texts whose normalized form is remembered
+  static constexpr std::size_t MAX_NORMALIZED_TEXTS = 1024;
+
+  //! Called for every row a statement returns (SQLITE_TRACE_ROW)
+  void recordRow(sqlite3_stmt* statement);
+  //! Called when a statement finishes running (SQLITE_TRACE_PROFILE)
+  void recordExecution(sqlite3_stmt* statement, std::chrono::nanoseconds elapsed);
+
+  //! All entries, slowest total time first
+  std::vector<QueryStats> getStats() const;
+  void reset();
+
+  //! Replaces literals with ?, drops comments and collapses whitespace
+  static std::string normalize(std::string_view sql);
+
+private:
+  // lets the maps be searched with a string_view without building a std::string
+  struct TextHash
+  {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+  };
+  using TextMap = std::unordered_map<std::string, std::string, TextHash, std::equal_to<>>;
+
+  std::unordered_map<std::string, QueryStats> _entries;
+  // normalized text of the first raw SQL texts seen, so that normalization runs once per query
+  TextMap _normalized;
+  // rows returned by statements that did not finish yet, there are rarely more than a few
+  std::vector<std::pair<sqlite3_stmt*, std::uint64_t>> _pendingRows;
+  mutable std::mutex _mutex;
+};
+
+}
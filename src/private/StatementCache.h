@@ -0,0 +1,68 @@
+#pragma once
+#include "Database.h"
+#include "flags.h"
+#include "generic/NoCopy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace sqlitepp
+{
+
+//! LRU cache of idle prepared statements keyed by SQL text.
+//! Statements are checked out with acquire and given back with release, so one handle
+//! is never used by two RawStatements at once. Idle handles are kept reset with bindings cleared.
+class StatementCache : public NoCopy
+{
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 64;
+
+  explicit StatementCache(std::size_t capacity = DEFAULT_CAPACITY) : _capacity(capacity) {}
+  ~StatementCache();
+
+  //! Returns an idle statement for the query, or prepares a new one. Throws on prepare error.
+  sqlite3_stmt* acquire(sqlite3* db, std::string_view sql, PrepareFlags flags);
+  //! Gives the statement back to the cache, it is reset and its bindings cleared.
+  //! If the cache is full, the least recently used statement is finalized.
+  void release(std::string_view sql, sqlite3_stmt* stmt, PrepareFlags flags);
+
+  //! Finalizes all idle statements
+  void clear();
+  //! Drops all idle statements if sql starts with CREATE, DROP or ALTER. Only looks at the text,
+  //! statements prepared with v2/v3 re-prepare themselves anyway, this just keeps their column
+  //! metadata from being read stale when they are handed out.
+  void invalidateIfSchemaStatement(const char* sql);
+
+  void setCapacity(std::size_t capacity);
+  StatementCacheStats getStats() const;
+
+private:
+  struct Entry
+  {
+    std::string sql;
+    PrepareFlags flags;
+    sqlite3_stmt* statement;
+  };
+  using EntryList = std::list<Entry>;
+
+  // most recently used entries are at the front
+  EntryList _lru;
+  // keys point into the sql strings owned by _lru
+  std::unordered_multimap<std::string_view, EntryList::iterator> _index;
+  std::size_t _capacity;
+  StatementCacheStats _stats;
+  mutable std::mutex _mutex;
+
+  void clearLocked();
+  void evictLocked(std::size_t targetSize);
+};
+
+}